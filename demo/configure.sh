@@ -79,11 +79,13 @@ cat <<-EOF >&3
 
 nao_variants=""
 se3_variants=""
+pprm_variants=""
 for scalar in float double ; do
     for nn in kd gnat ; do
         for t in st mt ; do
             nao_variants+=" \$builddir/nao_cup_planning-$nn-$scalar-$t"
             se3_variants+=" \$builddir/se3_rigid_body_planning-$nn-$scalar-$t"
+            pprm_variants+=" \$builddir/pprm_stress_benchmark-$nn-$scalar-$t"
             [[ $nn = kd ]] && NN="KDTreeBatch" || NN="GNAT"
             [[ $t = st ]] && MT=0 || MT=1
             cat <<-EOF >&3
@@ -97,6 +99,11 @@ for scalar in float double ; do
 		  scalar = $scalar
 		  mt = $MT
 
+		build \$builddir/pprm_stress_benchmark-$nn-$scalar-$t: cxx pprm_stress_benchmark.cpp
+		  nn = $NN
+		  scalar = $scalar
+		  mt = $MT
+
 		EOF
         done
     done
@@ -105,7 +112,8 @@ done
 cat <<-EOF >&3
 build nao_cup_planning: phony $nao_variants
 build se3_rigid_body_planning: phony $se3_variants
-build all: phony nao_cup_planning se3_rigid_body_planning
+build pprm_stress_benchmark: phony $pprm_variants
+build all: phony nao_cup_planning se3_rigid_body_planning pprm_stress_benchmark
 EOF
 
 exec 3>&- # close build.ninja
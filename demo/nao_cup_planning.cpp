@@ -34,12 +34,12 @@
 //! @author Jeff Ichnowski
 
 #include "nao_cup/src/naocup.hpp"
-#include "proc_info.hpp"
 #include <mpt/lp_space.hpp>
 #include <mpt/box_bounds.hpp>
 #include <mpt/prrt.hpp>
 #include <mpt/prrt_star.hpp>
 #include <mpt/goal_state.hpp>
+#include <atomic>
 #include <memory>
 #include <getopt.h>
 
@@ -92,13 +92,16 @@ namespace mpt_demo {
         }
 #endif
 
-        std::shared_ptr<unsigned> counter_;
+        // copies of the scenario share the system, and allocate
+        // their own instance data.  The counter is atomic since
+        // planners copy their workers' scenarios in parallel.
+        std::shared_ptr<std::atomic<unsigned>> counter_;
         unsigned no_;
         std::shared_ptr<nao_cup::prrts_system<S>> system_;
         mutable void *instance_;
 
         NaoCupScenario()
-            : counter_{new unsigned(0u)}
+            : counter_{std::make_shared<std::atomic<unsigned>>(0u)}
             , no_{(*counter_)++}
             , system_(nao_cup::naocup_create_system<S>(), nao_cup::naocup_free_system<S>)
             , instance_(system_->system_data_alloc_func(no_, nullptr, nullptr))
@@ -126,7 +129,8 @@ namespace mpt_demo {
 
         ~NaoCupScenario() {
             MPT_LOG(TRACE) << "free scenario " << no_;
-            system_->system_data_free_func(instance_);
+            if (instance_)
+                system_->system_data_free_func(instance_);
         }
 
         const Space& space() const {
@@ -220,8 +224,6 @@ int runPlanner(int solveTimeMillis, int nodeCount, bool terminateWhenSolved) {
         MPT_LOG(INFO) << "path cost " << cost;
     }
 
-    std::cout << ProcInfo() << std::flush;
-
     return 0;
 }
 
@@ -0,0 +1,268 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/lp_space.hpp>
+#include <mpt/box_bounds.hpp>
+#include <mpt/goal_state.hpp>
+#include <mpt/pprm.hpp>
+#include <nigh/gnat.hpp>
+#include <nigh/kdtree_batch.hpp>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+#include <getopt.h>
+
+// Stress benchmark for the concurrent PRM.  Repeatedly builds large
+// roadmaps in a unit hypercube cluttered with spherical obstacles,
+// and verifies that each resulting solution is a valid path.  Use
+// OMP_NUM_THREADS to set the number of threads, e.g.:
+//
+//     OMP_NUM_THREADS=64 build/pprm_stress_benchmark-kd-double-mt -n 200000 -r 20
+
+namespace mpt_demo {
+    using namespace unc::robotics::mpt;
+
+    template <typename S>
+    class SphereForestScenario {
+    public:
+        static constexpr int kDimensions = 6;
+        static constexpr int kObstacles = 40;
+        using Scalar = S;
+        using Space = L2Space<Scalar, kDimensions>;
+        using Config = typename Space::Type;
+        using Goal = GoalState<Space>;
+
+    private:
+        struct Sphere {
+            Config center_;
+            Scalar radius_;
+        };
+
+        // the obstacles are immutable, and shared between the copies
+        // of the scenario made for each thread.
+        std::shared_ptr<const std::vector<Sphere>> obstacles_;
+
+        Space space_;
+        BoxBounds<Scalar, kDimensions> bounds_{Config::Zero(), Config::Ones()};
+        Goal goal_;
+        Scalar checkResolution_{0.01};
+
+        static std::shared_ptr<const std::vector<Sphere>> makeObstacles(
+            const Config& start, const Config& goal)
+        {
+            // a sphere at the center blocks the straight line from
+            // start to goal, the rest are scattered randomly.
+            auto obstacles = std::make_shared<std::vector<Sphere>>();
+            obstacles->push_back(Sphere{Config::Constant(Scalar(0.5)), Scalar(0.35)});
+            std::mt19937_64 rng(1);
+            std::uniform_real_distribution<Scalar> unit(0, 1);
+            std::uniform_real_distribution<Scalar> radius(0.1, 0.25);
+            while (obstacles->size() < kObstacles) {
+                Sphere s;
+                for (int i=0 ; i<kDimensions ; ++i)
+                    s.center_[i] = unit(rng);
+                s.radius_ = radius(rng);
+                if ((s.center_ - start).norm() > s.radius_ && (s.center_ - goal).norm() > s.radius_)
+                    obstacles->push_back(s);
+            }
+            return obstacles;
+        }
+
+    public:
+        SphereForestScenario(const Config& start, const Config& goal)
+            : obstacles_(makeObstacles(start, goal))
+            , goal_(1e-5, goal)
+        {
+        }
+
+        const Space& space() const {
+            return space_;
+        }
+
+        const BoxBounds<Scalar, kDimensions>& bounds() const {
+            return bounds_;
+        }
+
+        const Goal& goal() const {
+            return goal_;
+        }
+
+        bool valid(const Config& q) const {
+            for (const Sphere& s : *obstacles_)
+                if ((q - s.center_).squaredNorm() < s.radius_ * s.radius_)
+                    return false;
+            return true;
+        }
+
+        bool link(const Config& a, const Config& b) const {
+            int steps = std::ceil((b - a).norm() / checkResolution_);
+            for (int i=1 ; i<=steps ; ++i)
+                if (!valid(a + (b - a) * (Scalar(i) / steps)))
+                    return false;
+            return true;
+        }
+    };
+}
+
+template <typename S, typename Algorithm>
+int runTrial(int trial, int solveTimeMillis, int nodeCount) {
+    using namespace mpt_demo;
+    using namespace unc::robotics::mpt;
+    using Scenario = SphereForestScenario<S>;
+    using Config = typename Scenario::Config;
+    using Clock = std::chrono::steady_clock;
+
+    Config qStart = Config::Constant(S(0.02));
+    Config qGoal = Config::Constant(S(0.98));
+
+    Scenario scenario(qStart, qGoal);
+    Planner<Scenario, Algorithm> planner(scenario);
+    planner.addStart(qStart);
+    planner.addGoal(qGoal);
+
+    auto start = Clock::now();
+    if (solveTimeMillis > 0) {
+        planner.solveFor(
+            [&, count = std::size_t(nodeCount)] { return planner.size() >= count; },
+            std::chrono::milliseconds(solveTimeMillis));
+    } else {
+        planner.solve([&, count = std::size_t(nodeCount)] { return planner.size() >= count; });
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    MPT_LOG(INFO) << "trial " << trial << ": " << planner.size() << " nodes in "
+                  << elapsed << " seconds (" << planner.size() / elapsed << " nodes/second)";
+    planner.printStats();
+
+    if (!planner.solved()) {
+        MPT_LOG(WARN) << "trial " << trial << ": not solved";
+        return 0;
+    }
+
+    std::vector<Config> path = planner.solution();
+    if (path.size() < 2 || path.front() != qStart || !scenario.goal()(scenario.space(), path.back()).first) {
+        MPT_LOG(ERROR) << "trial " << trial << ": solution does not connect start to goal";
+        return 1;
+    }
+
+    S cost = 0;
+    for (auto prev = path.begin(), curr = prev ; ++curr != path.end() ; prev = curr) {
+        if (!scenario.link(*prev, *curr)) {
+            MPT_LOG(ERROR) << "trial " << trial << ": solution contains an invalid motion";
+            return 1;
+        }
+        cost += scenario.space().distance(*prev, *curr);
+    }
+    MPT_LOG(INFO) << "trial " << trial << ": path cost " << cost;
+
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    using namespace unc::robotics::mpt;
+    using namespace unc::robotics::nigh;
+
+    static struct option options[] = {
+        { "solve-time", required_argument, 0, 't' },
+        { "node-count", required_argument, 0, 'n' },
+        { "trials", required_argument, 0, 'r' },
+        { nullptr, 0, nullptr, 0 }
+    };
+
+    int solveTimeMillis = -1;
+    int nodeCount = 50000;
+    int trials = 10;
+
+    try {
+        for (int c, optInd ; -1 != (c=getopt_long(argc, argv, "t:n:r:", options, &optInd)) ; ) {
+            std::size_t pos;
+            std::string arg;
+
+            switch (c) {
+            case 't':
+                arg = optarg;
+                solveTimeMillis = std::stoi(arg, &pos);
+                if (pos != arg.length() || solveTimeMillis < 0)
+                    throw std::invalid_argument("invalid solve time: " + arg);
+                break;
+            case 'n':
+                arg = optarg;
+                nodeCount = std::stoi(arg, &pos);
+                if (pos != arg.length() || nodeCount <= 0)
+                    throw std::invalid_argument("invalid node count: " + arg);
+                break;
+            case 'r':
+                arg = optarg;
+                trials = std::stoi(arg, &pos);
+                if (pos != arg.length() || trials <= 0)
+                    throw std::invalid_argument("invalid trial count: " + arg);
+                break;
+            default:
+                std::cerr << "Usage: " << argv[0] << " [options]\n"
+                    "Options:\n"
+                    "  -t --solve-time=T    Limit each trial to T milliseconds\n"
+                    "  -n --node-count=N    Run each trial until N nodes are generated\n"
+                    "  -r --trials=R        Run R trials\n"
+                          << std::flush;
+                throw std::invalid_argument("unrecognized option");
+            }
+        }
+
+        using S = SCALAR_TYPE;
+        using NN = NN_TYPE<>;
+#if MT
+        using Threads = hardware_concurrency;
+#else
+        using Threads = single_threaded;
+#endif
+        using Algorithm = PPRM<report_stats<true>, Threads, NN>;
+
+        MPT_LOG(INFO) << "Algorithm: " << log::type_name<Algorithm>();
+
+        int failures = 0;
+        for (int trial = 0 ; trial < trials ; ++trial)
+            failures += runTrial<S, Algorithm>(trial, solveTimeMillis, nodeCount);
+
+        if (failures) {
+            MPT_LOG(FATAL) << failures << " of " << trials << " trials failed";
+            return 1;
+        }
+        return 0;
+    } catch (const std::exception& ex) {
+        MPT_LOG(FATAL) << "terminated with exception: " << ex.what();
+        return 1;
+    }
+}
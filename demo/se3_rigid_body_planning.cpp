@@ -35,7 +35,6 @@
 
 #include "se3_rigid_body_scenario.hpp"
 #include "scenario_config.hpp"
-#include "proc_info.hpp"
 #include <mpt/pprm.hpp>
 #include <mpt/prrt.hpp>
 #include <mpt/prrt_star.hpp>
@@ -43,6 +42,7 @@
 #include <getopt.h>
 #include <iomanip>
 #include <chrono>
+#include <type_traits>
 
 // To compile:
 // cd ~/projects/mpt/demo ; clang++ -fopenmp -std=c++17 -I../src -I../../nigh/src -I/usr/local/include -I/usr/include/eigen3 -o se3_rigid_body_planning se3_rigid_body_planning.cpp -lfcl -lassimp
@@ -55,6 +55,18 @@
 //     }
 // }
 
+namespace mpt_demo {
+    // detects planners that support setRange(), e.g., PRRT and
+    // PRRTStar, but not PPRM.
+    template <typename Planner, typename Scalar, typename = void>
+    struct has_set_range : std::false_type {};
+
+    template <typename Planner, typename Scalar>
+    struct has_set_range<Planner, Scalar, std::void_t<
+        decltype(std::declval<Planner&>().setRange(std::declval<Scalar>()))>>
+        : std::true_type {};
+}
+
 enum PlanningAlgorithm {
     kRRTStarAlgorithm,
     kRRTAlgorithm,
@@ -64,6 +76,7 @@ enum PlanningAlgorithm {
 struct Options {
     int solveTimeMillis_{-1};
     int nodeCount_{-1};
+    int splitSteps_{0};
     bool terminateWhenSolved_{false};
     PlanningAlgorithm algorithm_{kRRTStarAlgorithm};
 
@@ -84,10 +97,11 @@ struct Options {
             { "nodes", required_argument, 0, 'n' },
             { "algorithm", required_argument, 0, 'a' },
             { "scalar", required_argument, 0, 's' },
+            { "split-steps", required_argument, 0, 'k' },
             { nullptr, 0, nullptr, 0}
         };
 
-        for (int c, optInd ; -1 != (c=getopt_long(argc, argv, "t:s:n:a:S", options, &optInd)) ; ) {
+        for (int c, optInd ; -1 != (c=getopt_long(argc, argv, "t:s:n:a:k:S", options, &optInd)) ; ) {
             std::size_t pos;
             std::string arg;
 
@@ -107,6 +121,12 @@ struct Options {
             case 'S':
                 terminateWhenSolved_ = true;
                 break;
+            case 'k':
+                arg = optarg;
+                splitSteps_ = std::stoi(arg, &pos);
+                if (pos != arg.length() || splitSteps_ < 0)
+                    throw std::invalid_argument("invalid split steps: " + arg);
+                break;
             case 'a':
                 if (std::strcmp("rrtstar", optarg) == 0) {
                     algorithm_ = kRRTStarAlgorithm;
@@ -115,7 +135,7 @@ struct Options {
                 } else if (std::strcmp("prm", optarg) == 0) {
                     algorithm_ = kPRMAlgorithm;
                 } else {
-                    throw std::invalid_argument("expected algorithm to be 'rrtstar' or 'rrt'");
+                    throw std::invalid_argument("expected algorithm to be 'rrtstar', 'rrt', or 'prm'");
                 }
                 break;
             case 's':
@@ -135,7 +155,8 @@ struct Options {
                     "  -t --solve-time=TIME   Specify the time in milliseconds to spend solving\n"
                     "  -S --solved            Run until solved\n"
                     "  -n --nodes=N           Run until planner has generated N\n"
-                    "  -a --algorithm=ALG     Run the planning algorithm (rrt or rrtstar)\n"
+                    "  -a --algorithm=ALG     Run the planning algorithm (rrt, rrtstar, or prm)\n"
+                    "  -k --split-steps=N     Split motion checks of N or more steps across idle threads\n"
                     "  -t TIME\n"
                           << std::flush;
                 throw std::invalid_argument("unrecognized option");
@@ -170,17 +191,22 @@ void runPlanner(
     using Clock = std::chrono::steady_clock;
 
     Scenario scenario(envMesh, robotMeshes, qGoal, volumeMin, volumeMax, 0.01);
+    if (options.splitSteps_ > 0) {
+        MPT_LOG(INFO) << "splitting motion checks of " << options.splitSteps_ << " or more steps";
+        scenario.setSplitSteps(options.splitSteps_);
+    }
 
     Planner<Scenario, Algorithm> planner(scenario);
     // planner.addGoal(qGoal);
     planner.addStart(qStart);
 
-    // TODO: only do this for Algorithms that have setRange
-    if (config.hasProp("planner", "rrt.range")) {
-        Scalar range;
-        config.load(range, "planner", "rrt.range");
-        MPT_LOG(INFO) << "setting range: " << range;
-        planner.setRange(range);
+    if constexpr (mpt_demo::has_set_range<Planner<Scenario, Algorithm>, Scalar>::value) {
+        if (config.hasProp("planner", "rrt.range")) {
+            Scalar range;
+            config.load(range, "planner", "rrt.range");
+            MPT_LOG(INFO) << "setting range: " << range;
+            planner.setRange(range);
+        }
     }
 
     Clock::time_point start;
@@ -229,8 +255,6 @@ void runPlanner(
             }
         }
     }
-
-    std::cout << mpt_demo::ProcInfo() << std::flush;
 }
 
 template <typename Scalar>
@@ -282,8 +306,8 @@ void solve(const Options& options, const mpt_demo::ScenarioConfig<>& config) {
         using Algorithm = PRRT<report_stats<reportStats>, NN, Threads>;
         runPlanner<Scenario, Algorithm>(options, config, envMesh, robotMeshes, qStart, qGoal, volumeMin, volumeMax);
     } else if (options.algorithm_ == kPRMAlgorithm) {
-        // using Algorithm = PPRM<report_stats<true>, NN, Threads>;
-        // runPlanner<Scenario, Algorithm>(options, config, envMesh, robotMeshes, qStart, qGoal, volumeMin, volumeMax);
+        using Algorithm = PPRM<report_stats<reportStats>, NN, Threads>;
+        runPlanner<Scenario, Algorithm>(options, config, envMesh, robotMeshes, qStart, qGoal, volumeMin, volumeMax);
     }
 }
 
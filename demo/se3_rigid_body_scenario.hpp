@@ -315,7 +315,7 @@ namespace mpt_demo {
         using Validator = impl::member_function<&SE3RigidBodyScenario::valid>;
 
     public:
-        const mpt::DiscreteMotionValidator<Space, Validator> link_;
+        mpt::DiscreteMotionValidator<Space, Validator> link_;
 
         template <typename Min, typename Max>
         SE3RigidBodyScenario(
@@ -344,6 +344,12 @@ namespace mpt_demo {
             return space_;
         }
 
+        // valid() is thread-safe, so long motions may be split
+        // across idle threads.  See DiscreteMotionValidator.
+        void setSplitSteps(std::size_t steps) {
+            link_.setSplitSteps(steps);
+        }
+
         const Bounds& bounds() const {
             return bounds_;
         }
@@ -38,7 +38,12 @@
 #define MPT_DISCRETE_MOTION_VALIDATOR_HPP
 
 #include "log.hpp"
+#include <algorithm>
 #include <array>
+#include <atomic>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace unc::robotics::mpt {
 
@@ -53,9 +58,49 @@ namespace unc::robotics::mpt {
         // should be a power of 2 for efficiency
         static constexpr std::size_t fixedBisectQueueSize_ = 256;
 
+        // when splitting a long motion into tasks, the number of
+        // tasks created per thread in the team.  More than 1 allows
+        // for some load balancing when threads join late.
+        static constexpr int tasksPerThread_ = 2;
+
         Space space_;
         Distance invStepSize_;
 
+        // motions with at least this many steps are split into tasks
+        // that idle threads can run.  0 disables splitting.
+        std::size_t splitSteps_{0};
+
+        bool splitValidate(const State& from, const State& to, std::size_t steps, Distance delta) const {
+#ifdef _OPENMP
+            // Each task checks a strided subset of the steps, so that
+            // every task covers the whole motion at a coarse
+            // resolution.  This gives every task a chance to find an
+            // invalid state early, at which point the remaining
+            // tasks stop.
+            std::size_t nTasks = std::min(
+                steps - 1, std::size_t(omp_get_num_threads()) * tasksPerThread_);
+            std::atomic_bool failed{false};
+
+#pragma omp taskgroup
+            {
+                for (std::size_t t=0 ; t<nTasks ; ++t) {
+#pragma omp task shared(failed, from, to) firstprivate(t) untied
+                    {
+                        for (std::size_t i=t+1 ; i<steps && !failed.load(std::memory_order_relaxed) ; i += nTasks)
+                            if (!static_cast<const StateValidator&>(*this)(interpolate(space_, from, to, i * delta)))
+                                failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            return !failed.load(std::memory_order_relaxed);
+#else
+            (void)from; (void)to; (void)steps; (void)delta;
+            assert(false);
+            return false;
+#endif
+        }
+
     public:
         template <typename ... Args>
         DiscreteMotionValidator(const Space& space, Distance stepSize, Args&& ... args)
@@ -68,6 +113,23 @@ namespace unc::robotics::mpt {
 
         using StateValidator::operator();
 
+        // Sets the number of steps at or above which a motion is
+        // split into OpenMP tasks.  When the planner runs with
+        // multiple threads, the tasks are picked up by threads that
+        // are idle (e.g., those that have reached the end of their
+        // time budget and are waiting on the others), instead of
+        // leaving a single thread to check a long motion alone.
+        // Since the tasks call the state validator concurrently, the
+        // state validator must be thread-safe to enable this.  The
+        // default of 0 never splits.
+        void setSplitSteps(std::size_t steps) {
+            splitSteps_ = steps;
+        }
+
+        std::size_t getSplitSteps() const {
+            return splitSteps_;
+        }
+
         bool operator() (const State& from, const State& to) const {
             // Assume the caller has verified that from is valid.
             assert(StateValidator::operator()(from));
@@ -81,6 +143,11 @@ namespace unc::robotics::mpt {
 
             Distance delta = Distance(1) / Distance(steps);
 
+#ifdef _OPENMP
+            if (splitSteps_ && steps >= splitSteps_ && omp_in_parallel() && omp_get_num_threads() > 1)
+                return splitValidate(from, to, steps, delta);
+#endif
+
             // MPT_LOG(DEBUG) << "steps = " << steps << ", delta = " << delta;
 #if 0
             // link: 28936 calls, 550.036 us avg, 3.819 us min, 23091.8 us max, 1.59158e+07 us total
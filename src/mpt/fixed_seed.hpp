@@ -0,0 +1,78 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_FIXED_SEED_HPP
+#define MPT_FIXED_SEED_HPP
+
+#include <cstdint>
+#include <random>
+
+namespace unc::robotics::mpt {
+
+    // A seed sequence that always generates the same seed data for
+    // the same value.  Unlike std::seed_seq, generate() is const, and
+    // thus this may be passed to a planner's constructor to make its
+    // random number generators reproducible.
+    class FixedSeed {
+        std::uint64_t value_;
+
+    public:
+        using result_type = std::uint32_t;
+
+        explicit FixedSeed(std::uint64_t value = 0)
+            : value_(value)
+        {
+        }
+
+        std::uint64_t value() const {
+            return value_;
+        }
+
+        template <class RandomIt>
+        void generate(RandomIt begin, RandomIt end) const {
+            std::seed_seq seq{
+                result_type(value_ & 0xffffffffu),
+                result_type(value_ >> 32) };
+            seq.generate(begin, end);
+        }
+
+        std::size_t size() const {
+            return 2;
+        }
+    };
+}
+
+#endif
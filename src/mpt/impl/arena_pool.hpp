@@ -0,0 +1,223 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_ARENA_POOL_HPP
+#define MPT_IMPL_ARENA_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace unc::robotics::mpt::impl {
+    // An ArenaPool has the same allocate() interface and ownership
+    // semantics as an ObjectPool, but allocates its objects
+    // contiguously from large blocks of blockSize bytes.  Objects are
+    // placed in slots sized so that no object straddles more cache
+    // lines than necessary: objects up to a cache line in size are
+    // placed in power-of-two slots, and larger objects are placed in
+    // slots that are a multiple of the cache line size.
+    //
+    // When hugePages is true, blocks are backed by huge pages, using
+    // explicitly reserved huge pages (MAP_HUGETLB) when available,
+    // and otherwise transparent huge pages.  Huge pages are only
+    // supported on Linux, and blockSize must then be a multiple of
+    // the huge page size.
+    //
+    // Blocks that are not backed by huge pages are allocated with
+    // Allocator (rebound as needed).
+    template <typename T, std::size_t blockSize = (std::size_t(2) << 20), bool hugePages = false,
+              class Allocator = std::allocator<T>>
+    class ArenaPool {
+    public:
+        static constexpr std::size_t kCacheLine = 64;
+        static constexpr std::size_t kHugePageSize = std::size_t(2) << 20;
+
+    private:
+        static constexpr std::size_t slotSize() {
+            std::size_t size = std::max(sizeof(T), alignof(T));
+            if (size > kCacheLine)
+                return (size + kCacheLine - 1) / kCacheLine * kCacheLine;
+            std::size_t slot = 1;
+            while (slot < size)
+                slot *= 2;
+            return slot;
+        }
+
+    public:
+        static constexpr std::size_t kSlotSize = slotSize();
+        static constexpr std::size_t kBlockCapacity = blockSize / kSlotSize;
+
+    private:
+        static_assert(alignof(T) <= kCacheLine, "over-aligned types are not supported");
+        static_assert(kBlockCapacity > 0, "block size is too small for the object type");
+        static_assert(!hugePages || blockSize % kHugePageSize == 0,
+                      "huge page blocks must be a multiple of the huge page size");
+
+        struct alignas(kCacheLine) CacheLine {
+            char bytes_[kCacheLine];
+        };
+
+        static constexpr std::size_t kBlockLines = (blockSize + kCacheLine - 1) / kCacheLine;
+
+        using LineAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<CacheLine>;
+        using LineTraits = std::allocator_traits<LineAllocator>;
+        using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<char*>;
+
+        LineAllocator alloc_;
+        std::vector<char*, BlockAllocator> blocks_;
+
+        // the number of objects allocated.  Objects fill the blocks
+        // in order, and blocks past the last object are retained
+        // from before the last clear().
+        std::size_t size_{0};
+
+        void destroy() {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                for (std::size_t i = 0 ; i < size_ ; ++i)
+                    reinterpret_cast<T*>(blocks_[i / kBlockCapacity] + (i % kBlockCapacity) * kSlotSize)->~T();
+        }
+
+        char* allocateBlock() {
+#ifdef __linux__
+            if constexpr (hugePages) {
+                void *p = ::mmap(nullptr, blockSize, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED)
+                    return static_cast<char*>(p);
+
+                // no huge pages are reserved, fall back to
+                // transparent huge pages, which require the block to
+                // be aligned to the huge page size.  We map extra,
+                // then unmap the unaligned ends.
+                std::size_t size = blockSize + kHugePageSize;
+                p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED)
+                    throw std::bad_alloc();
+                char *start = static_cast<char*>(p);
+                char *block = reinterpret_cast<char*>(
+                    (reinterpret_cast<std::uintptr_t>(start) + kHugePageSize - 1) & ~(kHugePageSize - 1));
+                if (block != start)
+                    ::munmap(start, block - start);
+                if (std::size_t tail = (start + size) - (block + blockSize))
+                    ::munmap(block + blockSize, tail);
+                ::madvise(block, blockSize, MADV_HUGEPAGE);
+                return block;
+            }
+#endif
+            return reinterpret_cast<char*>(std::addressof(*LineTraits::allocate(alloc_, kBlockLines)));
+        }
+
+        void releaseBlock(char *block) {
+#ifdef __linux__
+            if constexpr (hugePages) {
+                ::munmap(block, blockSize);
+                return;
+            }
+#endif
+            LineTraits::deallocate(alloc_, reinterpret_cast<CacheLine*>(block), kBlockLines);
+        }
+
+    public:
+        ArenaPool(const ArenaPool&) = delete;
+
+        ArenaPool() {
+        }
+
+        ArenaPool(ArenaPool&& other)
+            : alloc_(std::move(other.alloc_))
+            , blocks_(std::move(other.blocks_))
+            , size_(std::exchange(other.size_, 0))
+        {
+            other.blocks_.clear();
+        }
+
+        ~ArenaPool() {
+            destroy();
+            for (char *block : blocks_)
+                releaseBlock(block);
+        }
+
+        // the number of objects allocated
+        std::size_t size() const {
+            return size_;
+        }
+
+        // the bytes of the blocks allocated, including the blocks
+        // retained by clear().
+        std::size_t bytes() const {
+            return blocks_.size() * blockSize;
+        }
+
+        // destroys all objects, but keeps the blocks (and their
+        // already faulted-in pages) for reuse.
+        void clear() {
+            destroy();
+            size_ = 0;
+        }
+
+        // the i-th object allocated, for i < size().
+        T& operator [] (std::size_t i) {
+            return *reinterpret_cast<T*>(blocks_[i / kBlockCapacity] + (i % kBlockCapacity) * kSlotSize);
+        }
+
+        const T& operator [] (std::size_t i) const {
+            return *reinterpret_cast<const T*>(blocks_[i / kBlockCapacity] + (i % kBlockCapacity) * kSlotSize);
+        }
+
+        template <typename ... Args>
+        T* allocate(Args&& ... args) {
+            std::size_t b = size_ / kBlockCapacity;
+            if (b == blocks_.size()) {
+                blocks_.reserve(b + 1);
+                blocks_.push_back(allocateBlock());
+            }
+            T *p = new (blocks_[b] + (size_ % kBlockCapacity) * kSlotSize) T(std::forward<Args>(args)...);
+            ++size_;
+            return p;
+        }
+    };
+}
+
+#endif
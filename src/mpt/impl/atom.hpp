@@ -40,6 +40,7 @@
 #include <atomic>
 #include <cassert>
 #include <type_traits>
+#include <utility>
 
 namespace unc::robotics::mpt::impl {
     template <typename T>
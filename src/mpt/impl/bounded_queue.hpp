@@ -0,0 +1,141 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_BOUNDED_QUEUE_HPP
+#define MPT_IMPL_BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace unc::robotics::mpt::impl {
+    // BoundedQueue is a fixed-capacity, lock-free, multi-producer,
+    // multi-consumer FIFO queue.  It is based upon Dmitry Vyukov's
+    // bounded MPMC queue, in which each cell carries a sequence
+    // number that tells producers and consumers whether the cell is
+    // ready to be written or read.  Producers and consumers only
+    // contend on their respective head and tail counters, and then
+    // only with a single CAS per operation.
+    //
+    // The capacity must be a power of 2.  T must be default
+    // constructible and move assignable, as the cells are constructed
+    // up front and reused.
+    template <typename T>
+    class BoundedQueue {
+        static constexpr std::size_t kCacheLine = 64;
+
+        struct Cell {
+            std::atomic<std::size_t> sequence_;
+            T value_;
+        };
+
+        std::vector<Cell> cells_;
+        std::size_t mask_;
+
+        alignas(kCacheLine) std::atomic<std::size_t> enqueuePos_{0};
+        alignas(kCacheLine) std::atomic<std::size_t> dequeuePos_{0};
+
+    public:
+        explicit BoundedQueue(std::size_t capacity)
+            : cells_(capacity)
+            , mask_(capacity - 1)
+        {
+            assert(capacity >= 2 && (capacity & mask_) == 0);
+            for (std::size_t i=0 ; i<capacity ; ++i)
+                cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator = (const BoundedQueue&) = delete;
+
+        std::size_t capacity() const {
+            return cells_.size();
+        }
+
+        // Attempts to add a value to the end of the queue.  Returns
+        // false if the queue is full, in which case the value is left
+        // unchanged.
+        bool tryPush(T&& value) {
+            Cell *cell;
+            std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                std::size_t seq = cell->sequence_.load(std::memory_order_acquire);
+                std::ptrdiff_t dif = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+                if (dif == 0) {
+                    if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (dif < 0) {
+                    return false;
+                } else {
+                    pos = enqueuePos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->value_ = std::move(value);
+            cell->sequence_.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Attempts to remove the value at the front of the queue.
+        // Returns false if the queue is empty.
+        bool tryPop(T& value) {
+            Cell *cell;
+            std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                std::size_t seq = cell->sequence_.load(std::memory_order_acquire);
+                std::ptrdiff_t dif = std::ptrdiff_t(seq) - std::ptrdiff_t(pos + 1);
+                if (dif == 0) {
+                    if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (dif < 0) {
+                    return false;
+                } else {
+                    pos = dequeuePos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            value = std::move(cell->value_);
+            cell->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+            return true;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,161 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_CAS_STAT_HPP
+#define MPT_IMPL_CAS_STAT_HPP
+
+#include "../log.hpp"
+#include <array>
+#include <cstddef>
+
+namespace unc::robotics::mpt::impl {
+    // CASStat counts the number of compare-and-swap (CAS) loops
+    // executed, and the number of times each loop had to retry due
+    // to contention.  The retries are also collected in a histogram
+    // with power of 2 buckets (0, 1, 2-3, 4-7, ...), so that a few
+    // highly contended operations can be distinguished from many
+    // slightly contended ones.
+    //
+    // The usage pattern is to count retries in a local variable in
+    // the CAS loop, then add it to the stat once the loop completes:
+    //
+    //    unsigned retries = 0;
+    //    while (!x.compare_exchange_weak(...))
+    //        ++retries;
+    //    stat += retries;
+    //
+    // As with TimerStat, the CASStat<false> specialization does
+    // nothing, and allows the compiler to remove the counting.
+    template <bool enable = true>
+    class CASStat;
+
+    template <>
+    class CASStat<false> {
+    public:
+        static CASStat<false>& instance() {
+            static CASStat<false> s;
+            return s;
+        }
+
+        const CASStat& operator += (unsigned) const { return *this; }
+    };
+
+    template <>
+    class CASStat<true> {
+    public:
+        // the last bucket holds everything with 2^(kBuckets-2) or
+        // more retries.
+        static constexpr std::size_t kBuckets = 12;
+
+    private:
+        std::size_t ops_{0};
+        std::size_t retries_{0};
+        unsigned maxRetries_{0};
+        std::array<std::size_t, kBuckets> histogram_{};
+
+        static std::size_t bucket(unsigned retries) {
+            std::size_t b = 0;
+            while (retries && b+1 < kBuckets) {
+                retries >>= 1;
+                ++b;
+            }
+            return b;
+        }
+
+    public:
+        CASStat& operator += (unsigned retries) {
+            ++ops_;
+            retries_ += retries;
+            if (retries > maxRetries_)
+                maxRetries_ = retries;
+            ++histogram_[bucket(retries)];
+            return *this;
+        }
+
+        CASStat& operator += (const CASStat& other) {
+            ops_ += other.ops_;
+            retries_ += other.retries_;
+            if (other.maxRetries_ > maxRetries_)
+                maxRetries_ = other.maxRetries_;
+            for (std::size_t i=0 ; i<kBuckets ; ++i)
+                histogram_[i] += other.histogram_[i];
+            return *this;
+        }
+
+        std::size_t ops() const {
+            return ops_;
+        }
+
+        std::size_t retries() const {
+            return retries_;
+        }
+
+        unsigned maxRetries() const {
+            return maxRetries_;
+        }
+
+        // the number of operations that retried between 2^(i-1) and
+        // 2^i - 1 times (bucket 0 is operations without retries)
+        std::size_t histogram(std::size_t i) const {
+            return histogram_[i];
+        }
+
+        friend decltype(auto) operator << (log::Event& evt, const CASStat& stat) {
+            evt << stat.ops_ << " ops, " << stat.retries_ << " retries (max " << stat.maxRetries_ << ")";
+
+            // only print the histogram up to the last non-empty bucket
+            std::size_t n = kBuckets;
+            while (n > 1 && stat.histogram_[n-1] == 0)
+                --n;
+            if (n > 1) {
+                evt << ", histogram:";
+                for (std::size_t i=0 ; i<n ; ++i) {
+                    evt << ' ';
+                    if (i < 2)
+                        evt << i;
+                    else if (i+1 == kBuckets)
+                        evt << (1u << (i-1)) << '+';
+                    else
+                        evt << (1u << (i-1)) << '-' << ((1u << i) - 1);
+                    evt << ':' << stat.histogram_[i];
+                }
+            }
+            return evt;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,240 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_COMPACT_HEAP_HPP
+#define MPT_IMPL_COMPACT_HEAP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/mman.h>
+
+namespace unc::robotics::mpt::impl {
+    // The CompactHeap is a single region of virtual address space
+    // from which the pools of compact graphs (see the compact_graph
+    // tag) allocate their blocks.  Since every compact graph object
+    // is in the region, a pointer to one can be stored as a 32-bit
+    // index of kAlign-byte units from the region's base (see
+    // CompactPtr), which addresses up to 32 GiB.
+    //
+    // The region is reserved once per process, inaccessible and
+    // without committing memory.  Each block is made readable and
+    // writable when it is first handed out, and its pages are only
+    // backed as the pool touches them, thus a stray access to the
+    // rest of the region faults instead of committing memory.  Blocks
+    // are handed out to pools, which are typically owned by one
+    // worker each, thus the region is striped by worker a block at a
+    // time.  Blocks released by a pool are returned to the operating
+    // system and reused by the next pool that needs one.  The region
+    // is never unmapped, so that pools may safely outlive static
+    // destruction.
+    class CompactHeap {
+        static_assert(sizeof(void*) == 8, "the compact heap requires a 64-bit address space");
+
+    public:
+        static constexpr std::size_t kAlign = 8;
+        static constexpr std::size_t kSize = kAlign << 32;
+        static constexpr std::size_t kBlockSize = std::size_t(64) << 10;
+
+    private:
+        static inline char *base_{nullptr};
+
+        // the first block is never handed out, so that index 0 can
+        // represent nullptr.
+        std::atomic<std::size_t> next_{kBlockSize};
+
+        std::mutex mutex_;
+        std::vector<char*> free_;
+
+        CompactHeap() {
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+            flags |= MAP_NORESERVE;
+#endif
+            void *p = ::mmap(nullptr, kSize, PROT_NONE, flags, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+            base_ = static_cast<char*>(p);
+        }
+
+    public:
+        CompactHeap(const CompactHeap&) = delete;
+
+        static CompactHeap& instance() {
+            static CompactHeap *heap = new CompactHeap();
+            return *heap;
+        }
+
+        static char* base() {
+            return base_;
+        }
+
+        char* allocateBlock() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!free_.empty()) {
+                    char *block = free_.back();
+                    free_.pop_back();
+                    return block;
+                }
+            }
+            std::size_t offset = next_.fetch_add(kBlockSize, std::memory_order_relaxed);
+            if (offset + kBlockSize > kSize)
+                throw std::bad_alloc();
+            char *block = base_ + offset;
+            if (::mprotect(block, kBlockSize, PROT_READ | PROT_WRITE) != 0)
+                throw std::bad_alloc();
+            return block;
+        }
+
+        // returns the block's pages to the operating system, leaving
+        // the block writable for the next pool that allocates it.
+        void releaseBlock(char *block) {
+            ::madvise(block, kBlockSize, MADV_DONTNEED);
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(block);
+        }
+
+        // the index of p, which must be nullptr or an object allocated
+        // from the heap.  Throws std::invalid_argument otherwise, since
+        // the truncated index would silently refer to another object.
+        static std::uint32_t encode(const void *p) {
+            if (p == nullptr)
+                return 0;
+            std::size_t offset = static_cast<std::size_t>(
+                reinterpret_cast<std::uintptr_t>(p) - reinterpret_cast<std::uintptr_t>(base_));
+            if (base_ == nullptr || offset >= kSize || offset % kAlign != 0)
+                throw std::invalid_argument("pointer is not in the compact heap");
+            return static_cast<std::uint32_t>(offset / kAlign);
+        }
+
+        template <typename T>
+        static T* decode(std::uint32_t index) {
+            return index == 0 ? nullptr : reinterpret_cast<T*>(base_ + std::size_t(index) * kAlign);
+        }
+    };
+
+    // A CompactPool has the same interface as an ArenaPool, but
+    // allocates its blocks from the CompactHeap, thus the objects it
+    // allocates may be referred to by CompactPtrs.  Objects are
+    // placed in slots rounded up to the heap's alignment.
+    template <typename T>
+    class CompactPool {
+    public:
+        static constexpr std::size_t kSlotAlign = std::max(alignof(T), CompactHeap::kAlign);
+        static constexpr std::size_t kSlotSize = (sizeof(T) + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+        static constexpr std::size_t kBlockCapacity = CompactHeap::kBlockSize / kSlotSize;
+
+    private:
+        static_assert(kBlockCapacity > 0, "object is too large for a compact pool");
+        static_assert(CompactHeap::kBlockSize % kSlotAlign == 0, "object is over-aligned for a compact pool");
+
+        std::vector<char*> blocks_;
+        std::size_t size_{0};
+
+        void destroy() {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                for (std::size_t i = 0 ; i < size_ ; ++i)
+                    reinterpret_cast<T*>(blocks_[i / kBlockCapacity] + (i % kBlockCapacity) * kSlotSize)->~T();
+        }
+
+    public:
+        CompactPool(const CompactPool&) = delete;
+
+        CompactPool() {
+        }
+
+        CompactPool(CompactPool&& other)
+            : blocks_(std::move(other.blocks_))
+            , size_(std::exchange(other.size_, 0))
+        {
+            other.blocks_.clear();
+        }
+
+        ~CompactPool() {
+            destroy();
+            for (char *block : blocks_)
+                CompactHeap::instance().releaseBlock(block);
+        }
+
+        // the number of objects allocated
+        std::size_t size() const {
+            return size_;
+        }
+
+        // the bytes of the blocks allocated, including the blocks
+        // retained by clear().
+        std::size_t bytes() const {
+            return blocks_.size() * CompactHeap::kBlockSize;
+        }
+
+        // destroys all objects, but keeps the blocks for reuse.
+        void clear() {
+            destroy();
+            size_ = 0;
+        }
+
+        // the i-th object allocated, for i < size().
+        T& operator [] (std::size_t i) {
+            return *reinterpret_cast<T*>(blocks_[i / kBlockCapacity] + (i % kBlockCapacity) * kSlotSize);
+        }
+
+        const T& operator [] (std::size_t i) const {
+            return *reinterpret_cast<const T*>(blocks_[i / kBlockCapacity] + (i % kBlockCapacity) * kSlotSize);
+        }
+
+        template <typename ... Args>
+        T* allocate(Args&& ... args) {
+            std::size_t b = size_ / kBlockCapacity;
+            if (b == blocks_.size()) {
+                blocks_.reserve(b + 1);
+                blocks_.push_back(CompactHeap::instance().allocateBlock());
+            }
+            T *p = new (blocks_[b] + (size_ % kBlockCapacity) * kSlotSize) T(std::forward<Args>(args)...);
+            ++size_;
+            return p;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,136 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_COMPACT_PTR_HPP
+#define MPT_IMPL_COMPACT_PTR_HPP
+
+#include "compact_heap.hpp"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace unc::robotics::mpt::impl {
+    // CompactPtr and AtomicCompactPtr are 32-bit pointers to objects
+    // allocated from a CompactPool.  They store the object's index
+    // in the CompactHeap, thus halve the size of a pointer field, and
+    // make atomic operations on it 32-bit.  An index of 0 represents
+    // nullptr.  Unlike OffsetPtr, the value does not depend on the
+    // pointer's own address, thus both may be copied by value.
+
+    template <typename T>
+    class CompactPtr {
+        std::uint32_t index_{0};
+
+    public:
+        CompactPtr(T *p = nullptr)
+            : index_(CompactHeap::encode(p))
+        {
+        }
+
+        CompactPtr& operator = (T *p) {
+            index_ = CompactHeap::encode(p);
+            return *this;
+        }
+
+        T* get() const {
+            return CompactHeap::decode<T>(index_);
+        }
+
+        operator T* () const {
+            return get();
+        }
+
+        T* operator -> () const {
+            return get();
+        }
+    };
+
+    // AtomicCompactPtr mirrors the subset of std::atomic<T*> used by
+    // the lock-free graph structures, so that they may swap one for
+    // the other.
+    template <typename T>
+    class AtomicCompactPtr {
+        std::atomic<std::uint32_t> index_;
+
+    public:
+        AtomicCompactPtr(T *p = nullptr)
+            : index_(CompactHeap::encode(p))
+        {
+        }
+
+        AtomicCompactPtr(const AtomicCompactPtr&) = delete;
+        AtomicCompactPtr& operator = (const AtomicCompactPtr&) = delete;
+
+        T* load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return CompactHeap::decode<T>(index_.load(order));
+        }
+
+        void store(T *p, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            index_.store(CompactHeap::encode(p), order);
+        }
+
+        bool compare_exchange_weak(
+            T*& expected, T *desired,
+            std::memory_order success, std::memory_order failure) noexcept
+        {
+            std::uint32_t e = CompactHeap::encode(expected);
+            if (index_.compare_exchange_weak(e, CompactHeap::encode(desired), success, failure))
+                return true;
+            expected = CompactHeap::decode<T>(e);
+            return false;
+        }
+
+        bool compare_exchange_strong(
+            T*& expected, T *desired,
+            std::memory_order success, std::memory_order failure) noexcept
+        {
+            std::uint32_t e = CompactHeap::encode(expected);
+            if (index_.compare_exchange_strong(e, CompactHeap::encode(desired), success, failure))
+                return true;
+            expected = CompactHeap::decode<T>(e);
+            return false;
+        }
+    };
+
+    // Selects between raw and compact pointers for graph structures.
+    template <typename T, bool compact>
+    using cptr_t = std::conditional_t<compact, CompactPtr<T>, T*>;
+
+    template <typename T, bool compact>
+    using atomic_cptr_t = std::conditional_t<compact, AtomicCompactPtr<T>, std::atomic<T*>>;
+}
+
+#endif
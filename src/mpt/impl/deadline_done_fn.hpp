@@ -0,0 +1,144 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_DEADLINE_DONE_FN_HPP
+#define MPT_IMPL_DEADLINE_DONE_FN_HPP
+
+#include <algorithm>
+#include <chrono>
+
+namespace unc::robotics::mpt::impl {
+    struct NeverDone {
+        constexpr bool operator() () const { return false; }
+    };
+
+    // DeadlineDoneFn is a done predicate for solve() that returns
+    // true once a deadline has passed (or the wrapped predicate
+    // returns true).  Unlike ConditionTimer, it does not start a
+    // thread to wait on the deadline.  Instead it reads the clock
+    // directly, but only every N calls, where N adapts to the
+    // measured time between calls, so that the clock is read about
+    // once every pollPeriod.  This keeps the overhead of reading the
+    // clock low when iterations are cheap, and keeps the overshoot of
+    // the deadline low when iterations are expensive.
+    //
+    // The state is updated on each call, and is thus not safe to call
+    // concurrently.  This matches the planners' usage, in which only
+    // one worker calls the done predicate passed to solve(), and
+    // signals the other workers.
+    template <typename Clock = std::chrono::steady_clock, typename Pred = NeverDone>
+    class DeadlineDoneFn {
+    public:
+        using TimePoint = typename Clock::time_point;
+        using Duration = typename Clock::duration;
+
+    private:
+        // do not let the interval grow by more than this factor per
+        // poll, so that a few quick iterations do not cause a large
+        // overshoot when followed by slower ones.
+        static constexpr unsigned kMaxGrowth = 2;
+
+        TimePoint deadline_;
+        Pred pred_;
+        Duration pollPeriod_;
+        TimePoint lastPoll_;
+        unsigned interval_{1};
+        unsigned countdown_{1};
+        bool done_{false};
+
+    public:
+        static constexpr Duration defaultPollPeriod() {
+            return std::chrono::duration_cast<Duration>(std::chrono::microseconds(50));
+        }
+
+        explicit DeadlineDoneFn(
+            const TimePoint& deadline,
+            Pred pred = Pred(),
+            Duration pollPeriod = defaultPollPeriod())
+            : deadline_(deadline)
+            , pred_(std::move(pred))
+            , pollPeriod_(pollPeriod)
+            , lastPoll_(Clock::now())
+        {
+        }
+
+        const TimePoint& deadline() const {
+            return deadline_;
+        }
+
+        // the current number of calls between reads of the clock
+        unsigned interval() const {
+            return interval_;
+        }
+
+        bool operator() () {
+            if (done_)
+                return true;
+
+            if (pred_())
+                return done_ = true;
+
+            if (--countdown_)
+                return false;
+
+            TimePoint now = Clock::now();
+            if (now >= deadline_)
+                return done_ = true;
+
+            // estimate the cost of an iteration from the time since
+            // the last poll, then pick the next interval to poll
+            // about once per poll period, without running past the
+            // deadline.
+            Duration perCall = std::max(Duration(1), (now - lastPoll_) / interval_);
+            Duration wait = std::min(pollPeriod_, deadline_ - now);
+            auto next = std::max(decltype(wait.count())(1), wait.count() / perCall.count());
+            interval_ = static_cast<unsigned>(
+                std::min(next, decltype(next)(interval_) * kMaxGrowth));
+
+            lastPoll_ = now;
+            countdown_ = interval_;
+            return false;
+        }
+    };
+
+    template <typename Clock, typename Duration, typename Pred = NeverDone>
+    auto deadlineDoneFn(const std::chrono::time_point<Clock, Duration>& deadline, Pred pred = Pred()) {
+        return DeadlineDoneFn<Clock, Pred>(
+            std::chrono::time_point_cast<typename Clock::duration>(deadline), std::move(pred));
+    }
+}
+
+#endif
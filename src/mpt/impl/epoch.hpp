@@ -0,0 +1,190 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_EPOCH_HPP
+#define MPT_IMPL_EPOCH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace unc::robotics::mpt::impl {
+    // Epoch-based reclamation of objects shared between threads.
+    // Each participant (i.e., worker) enters the domain before
+    // loading pointers to shared objects that may be retired, and
+    // leaves it when it no longer holds such pointers.  An object
+    // that is retired in epoch e, after it has become unreachable,
+    // may be reused once the global epoch reaches e+2, since by
+    // then every participant has left the critical section it may
+    // have been in when the object was retired.
+    //
+    // When enable is false, all operations are no-ops.
+    template <bool enable = true>
+    class EpochDomain;
+
+    template <>
+    class EpochDomain<false> {
+    public:
+        explicit EpochDomain(unsigned) {}
+        std::uint64_t current() const { return 0; }
+        void enter(unsigned) {}
+        void leave(unsigned) {}
+        bool tryAdvance() { return false; }
+    };
+
+    template <>
+    class EpochDomain<true> {
+        static constexpr std::uint64_t kInactive = ~std::uint64_t(0);
+
+        // each participant's announced epoch is on its own cache
+        // line, as it is written on every entry and exit.
+        struct alignas(64) Slot {
+            std::atomic<std::uint64_t> epoch_{kInactive};
+        };
+
+        alignas(64) std::atomic<std::uint64_t> epoch_{0};
+        std::unique_ptr<Slot[]> slots_;
+        unsigned size_;
+
+    public:
+        explicit EpochDomain(unsigned participants)
+            : slots_(new Slot[participants])
+            , size_(participants)
+        {
+        }
+
+        std::uint64_t current() const {
+            return epoch_.load(std::memory_order_seq_cst);
+        }
+
+        void enter(unsigned no) {
+            slots_[no].epoch_.store(epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+
+        void leave(unsigned no) {
+            slots_[no].epoch_.store(kInactive, std::memory_order_release);
+        }
+
+        // advances the global epoch if every participant in a
+        // critical section has entered it in the current epoch.
+        bool tryAdvance() {
+            std::uint64_t e = epoch_.load(std::memory_order_seq_cst);
+            for (unsigned i=0 ; i<size_ ; ++i) {
+                std::uint64_t a = slots_[i].epoch_.load(std::memory_order_seq_cst);
+                if (a != kInactive && a != e)
+                    return false;
+            }
+            return epoch_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+        }
+    };
+
+    // RAII critical section of an EpochDomain
+    template <bool enable>
+    class EpochGuard {
+        EpochDomain<enable>& domain_;
+        unsigned no_;
+
+    public:
+        EpochGuard(const EpochGuard&) = delete;
+
+        EpochGuard(EpochDomain<enable>& domain, unsigned no)
+            : domain_(domain)
+            , no_(no)
+        {
+            domain_.enter(no_);
+        }
+
+        ~EpochGuard() {
+            domain_.leave(no_);
+        }
+    };
+
+    // A participant's retired objects, and the objects that are
+    // safe to reuse.  Objects are retired in epoch order, thus
+    // reclaim() only needs to check the oldest.  The containers are
+    // allocated with Allocator, rebound as needed.
+    template <typename T, class Allocator = std::allocator<T*>>
+    class EpochLimbo {
+        using Retired = std::pair<std::uint64_t, T*>;
+        using AllocTraits = std::allocator_traits<Allocator>;
+
+        std::deque<Retired, typename AllocTraits::template rebind_alloc<Retired>> retired_;
+        std::vector<T*, typename AllocTraits::template rebind_alloc<T*>> free_;
+
+    public:
+        std::size_t retired() const {
+            return retired_.size();
+        }
+
+        std::size_t available() const {
+            return free_.size();
+        }
+
+        void retire(T *p, std::uint64_t epoch) {
+            retired_.emplace_back(epoch, p);
+        }
+
+        // makes objects retired two or more epochs before the
+        // specified epoch available for reuse.
+        void reclaim(std::uint64_t epoch) {
+            while (!retired_.empty() && retired_.front().first + 2 <= epoch) {
+                free_.push_back(retired_.front().second);
+                retired_.pop_front();
+            }
+        }
+
+        // forgets all retired objects, e.g., when the pool they were
+        // allocated from is cleared.
+        void clear() {
+            retired_.clear();
+            free_.clear();
+        }
+
+        // returns an object to reuse, or null if none are available.
+        T* reuse() {
+            if (free_.empty())
+                return nullptr;
+            T *p = free_.back();
+            free_.pop_back();
+            return p;
+        }
+    };
+}
+
+#endif
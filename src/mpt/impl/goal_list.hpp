@@ -0,0 +1,145 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_GOAL_LIST_HPP
+#define MPT_IMPL_GOAL_LIST_HPP
+
+#include "atom.hpp"
+#include <cstddef>
+
+namespace unc::robotics::mpt::impl {
+    // A GoalList is an intrusive, lock-free, singly-linked list of
+    // the goal nodes found by a planner.  Along with the list, it
+    // tracks the lowest cost goal added, so that checking for and
+    // retrieving the best solution does not require scanning the
+    // list.
+    //
+    // The list does not own its Goal records.  The intended usage is
+    // for each worker to allocate Goals from its own ObjectPool, and
+    // then push them onto the list shared by all workers.  As with
+    // the rest of the graph, the Goals must remain valid for the
+    // lifetime of the list.
+    template <typename Node, typename Distance, bool concurrent>
+    class GoalList {
+    public:
+        class Goal {
+            Node *node_;
+            Distance cost_;
+            Goal *next_{nullptr};
+
+            friend class GoalList;
+
+        public:
+            Goal(Node *node, Distance cost)
+                : node_(node)
+                , cost_(cost)
+            {
+            }
+
+            Node* node() const {
+                return node_;
+            }
+
+            Distance cost() const {
+                return cost_;
+            }
+
+            const Goal* next() const {
+                return next_;
+            }
+        };
+
+    private:
+        Atom<Goal*, concurrent> head_{nullptr};
+        Atom<Goal*, concurrent> best_{nullptr};
+        Atom<std::size_t, concurrent> size_{0};
+
+    public:
+        bool empty() const {
+            return head_.load(std::memory_order_relaxed) == nullptr;
+        }
+
+        std::size_t size() const {
+            return size_.load(std::memory_order_relaxed);
+        }
+
+        const Goal* head() const {
+            return head_.load(std::memory_order_acquire);
+        }
+
+        // Returns the lowest cost goal added so far, or nullptr if
+        // the list is empty.
+        const Goal* best() const {
+            return best_.load(std::memory_order_acquire);
+        }
+
+        // Adds a goal to the list, and returns true if the goal is
+        // the new best goal.
+        bool push(Goal *goal) {
+            Goal *head = head_.load(std::memory_order_relaxed);
+            do {
+                goal->next_ = head;
+            } while (!head_.compare_exchange_weak(
+                         head, goal,
+                         std::memory_order_release,
+                         std::memory_order_relaxed));
+
+            size_.fetch_add(1, std::memory_order_relaxed);
+
+            // acquire, since best->cost_ was written by the thread
+            // that published best.
+            Goal *best = best_.load(std::memory_order_acquire);
+            while (best == nullptr || goal->cost_ < best->cost_)
+                if (best_.compare_exchange_weak(
+                        best, goal,
+                        std::memory_order_release,
+                        std::memory_order_acquire))
+                    return true;
+
+            return false;
+        }
+
+        // Empties the list.  Not safe to call concurrently with
+        // push().
+        void clear() {
+            head_.store(nullptr, std::memory_order_relaxed);
+            best_.store(nullptr, std::memory_order_relaxed);
+            size_.store(0, std::memory_order_relaxed);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,145 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_MEMORY_BUDGET_HPP
+#define MPT_IMPL_MEMORY_BUDGET_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace unc::robotics::mpt::impl {
+    // A MemoryBudget tracks the bytes allocated by a planner's pools
+    // against a limit of `limit` bytes (see the memory_budget tag).
+    // Workers report their usage through a MemoryCharge, which only
+    // updates the shared count once their usage has grown by
+    // kChargeBytes, so that the count is not contended on every
+    // allocation.  The count may thus trail the actual usage by up
+    // to kChargeBytes per worker, and the budget is considered
+    // reached once it is within that amount of the limit.
+    //
+    // A limit of 0 disables the budget, in which case nothing is
+    // tracked.
+    template <std::size_t limit>
+    class MemoryBudget {
+        std::atomic<std::size_t> used_{0};
+        std::atomic_bool reached_{false};
+
+    public:
+        static constexpr std::size_t kChargeBytes = std::size_t(16) << 10;
+
+        // the bytes charged so far
+        std::size_t used() const {
+            return used_.load(std::memory_order_relaxed);
+        }
+
+        void charge(std::size_t bytes) {
+            used_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        // true once a done predicate returned by doneFn() stopped
+        // solving because of the budget.
+        bool reached() const {
+            return reached_.load(std::memory_order_relaxed);
+        }
+
+        // true when the charges of `workers` workers may have reached
+        // the limit.
+        bool near(unsigned workers) const {
+            return used() + workers * kChargeBytes >= limit;
+        }
+
+        // returns a done predicate for solve() that returns true once
+        // the budget is near, or once the wrapped predicate does.
+        template <typename DoneFn>
+        auto doneFn(unsigned workers, DoneFn done) {
+            reached_.store(false, std::memory_order_relaxed);
+            return [this, workers, done = std::move(done)] () mutable {
+                if (near(workers)) {
+                    reached_.store(true, std::memory_order_relaxed);
+                    return true;
+                }
+                return done();
+            };
+        }
+    };
+
+    template <>
+    class MemoryBudget<0> {
+    public:
+        static constexpr std::size_t used() { return 0; }
+        static constexpr bool reached() { return false; }
+
+        template <typename DoneFn>
+        DoneFn doneFn(unsigned, DoneFn done) {
+            return done;
+        }
+    };
+
+    // A worker's share of a MemoryBudget.  The worker calls update()
+    // with its total usage after each allocation (or batch of them).
+    template <std::size_t limit>
+    class MemoryCharge {
+        std::size_t charged_{0};
+
+    public:
+        // the bytes this worker has charged to the budget
+        std::size_t charged() const {
+            return charged_;
+        }
+
+        void update(MemoryBudget<limit>& budget, std::size_t bytes) {
+            if (bytes >= charged_ + MemoryBudget<limit>::kChargeBytes) {
+                budget.charge(bytes - charged_);
+                charged_ = bytes;
+            }
+        }
+    };
+
+    template <>
+    class MemoryCharge<0> {
+    public:
+        static constexpr std::size_t charged() { return 0; }
+        void update(MemoryBudget<0>&, std::size_t) {}
+    };
+
+    // An estimate of the bytes the nearest neighbor index uses per
+    // entry, for the entry itself and its share of the index's
+    // internal structure.
+    constexpr std::size_t kNNBytesPerEntry = 2 * sizeof(void*);
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_MEMORY_STATS_HPP
+#define MPT_IMPL_MEMORY_STATS_HPP
+
+#include "../log.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace unc::robotics::mpt::impl {
+    // MemoryStats collects the number of objects in, and the bytes
+    // used by, each of a planner's pools and buffers, by name.
+    // Unlike process-wide allocator statistics, this attributes the
+    // memory to the structure that uses it (e.g., nodes vs. edges vs.
+    // the nearest neighbor index).  Pools report the bytes of their
+    // allocated blocks, and buffers report their capacity, thus bytes
+    // may exceed objects times the object size.
+    class MemoryStats {
+        struct Entry {
+            const char *name_;
+            std::size_t objects_;
+            std::size_t bytes_;
+        };
+
+        std::vector<Entry> entries_;
+
+    public:
+        // adds to the entry with the given name, creating it if
+        // needed.
+        void add(const char *name, std::size_t objects, std::size_t bytes) {
+            for (Entry& e : entries_) {
+                if (std::strcmp(e.name_, name) == 0) {
+                    e.objects_ += objects;
+                    e.bytes_ += bytes;
+                    return;
+                }
+            }
+            entries_.push_back(Entry{name, objects, bytes});
+        }
+
+        // moves objects and bytes from the entry named from to the
+        // entry named to, e.g., to report part of a pool apart from
+        // the rest.  The from entry must have at least as many.
+        void move(const char *from, const char *to, std::size_t objects, std::size_t bytes) {
+            for (Entry& e : entries_) {
+                if (std::strcmp(e.name_, from) == 0) {
+                    assert(e.objects_ >= objects && e.bytes_ >= bytes);
+                    e.objects_ -= objects;
+                    e.bytes_ -= bytes;
+                    add(to, objects, bytes);
+                    return;
+                }
+            }
+            assert(objects == 0 && bytes == 0);
+        }
+
+        template <typename Pool>
+        void addPool(const char *name, const Pool& pool) {
+            add(name, pool.size(), pool.bytes());
+        }
+
+        template <typename T, typename Allocator>
+        void addVector(const char *name, const std::vector<T, Allocator>& vec) {
+            add(name, vec.size(), vec.capacity() * sizeof(T));
+        }
+
+        MemoryStats& operator += (const MemoryStats& other) {
+            for (const Entry& e : other.entries_)
+                add(e.name_, e.objects_, e.bytes_);
+            return *this;
+        }
+
+        // the objects in the named entry, or 0 if there is none.
+        std::size_t objects(const char *name) const {
+            for (const Entry& e : entries_)
+                if (std::strcmp(e.name_, name) == 0)
+                    return e.objects_;
+            return 0;
+        }
+
+        // the bytes in the named entry, or 0 if there is none.
+        std::size_t bytes(const char *name) const {
+            for (const Entry& e : entries_)
+                if (std::strcmp(e.name_, name) == 0)
+                    return e.bytes_;
+            return 0;
+        }
+
+        // the bytes of all entries
+        std::size_t bytes() const {
+            std::size_t sum = 0;
+            for (const Entry& e : entries_)
+                sum += e.bytes_;
+            return sum;
+        }
+
+        void print(const std::string& label) const {
+            for (const Entry& e : entries_)
+                MPT_LOG(INFO) << label << " memory, " << e.name_ << ": "
+                              << e.objects_ << " objects, " << e.bytes_ << " bytes";
+            MPT_LOG(INFO) << label << " memory: " << bytes() << " bytes";
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,76 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_NN_INSERT_HPP
+#define MPT_IMPL_NN_INSERT_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace unc::robotics::mpt::impl {
+    // A nearest neighbor structure may optionally insert a range of
+    // elements in one call:
+    //
+    //    template <class Iter> void insert(Iter first, Iter last);
+    //
+    // which lets it synchronize (and rebalance) once for the whole
+    // range instead of once per element.
+
+    template <typename NN, typename Iter, class = void>
+    struct nn_has_range_insert : std::false_type {};
+
+    template <typename NN, typename Iter>
+    struct nn_has_range_insert<NN, Iter, std::void_t<decltype(
+        std::declval<NN&>().insert(std::declval<Iter>(), std::declval<Iter>()))>>
+        : std::true_type {};
+
+    template <typename NN, typename Iter>
+    constexpr bool nn_has_range_insert_v = nn_has_range_insert<NN, Iter>::value;
+
+    // Inserts [first, last) into the nearest neighbor structure, with
+    // its range insert when it has one, otherwise one at a time.
+    template <typename NN, typename Iter>
+    void nnInsert(NN& nn, Iter first, Iter last) {
+        if constexpr (nn_has_range_insert_v<NN, Iter>) {
+            nn.insert(first, last);
+        } else {
+            for ( ; first != last ; ++first)
+                nn.insert(*first);
+        }
+    }
+}
+
+#endif
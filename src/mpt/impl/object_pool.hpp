@@ -37,8 +37,11 @@
 #ifndef MPT_IMPL_OBJECT_POOL_HPP
 #define MPT_IMPL_OBJECT_POOL_HPP
 
-#include <deque>
+#include <algorithm>
 #include <forward_list>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace unc::robotics::mpt::impl {
     // An ObjectPool is an (optionally) block-allocated, moveable,
@@ -51,8 +54,9 @@ namespace unc::robotics::mpt::impl {
     // (e.g. the graph of a planner).
     //
     // Once an object is allocated from the pool it will remain valid,
-    // until the pool is destroyed.  Thus the only exposed methods of
-    // a pool are guaranteed to keep pointers valid.  It also means
+    // until the pool is destroyed or cleared.  Thus the only exposed
+    // methods of a pool, other than clear(), are guaranteed to keep
+    // pointers valid.  It also means
     // that ObjectPools are movable, but not copiable, as copying
     // would have ill-defined semantics when it comes to the resulting
     // pointers.
@@ -62,13 +66,31 @@ namespace unc::robotics::mpt::impl {
     template <typename T, bool block = true, class Allocator = std::allocator<T>>
     class ObjectPool;
 
-    // The block-allocated specialization of ObjectPool currently uses
-    // a std::deque as its underlying container implementation.  A
-    // std::deque performs block allocation, and does not invalidate
-    // pointers (like std::vector would).
+    // The block-allocated specialization of ObjectPool allocates
+    // objects in blocks of kBlockObjects, in order, like a std::deque
+    // (which it previously used).  Blocks are never moved, thus
+    // allocating does not invalidate pointers (like std::vector
+    // would).  Unlike a std::deque, clear() keeps the blocks, so that
+    // a pool that is cleared and refilled (e.g., by a planner that is
+    // reset between queries) does not return to the allocator.
     template <typename T, class Allocator>
-    class ObjectPool<T, true, Allocator> : std::deque<T, Allocator> {
-        using Base = std::deque<T, Allocator>;
+    class ObjectPool<T, true, Allocator> {
+        using AllocTraits = std::allocator_traits<Allocator>;
+        using BlockAllocator = typename AllocTraits::template rebind_alloc<T*>;
+
+    public:
+        static constexpr std::size_t kBlockObjects = std::max(std::size_t(8), 4096 / sizeof(T));
+
+    private:
+        Allocator alloc_;
+        std::vector<T*, BlockAllocator> blocks_;
+        std::size_t size_{0};
+
+        void destroy() {
+            for (std::size_t i = 0 ; i < size_ ; ++i)
+                AllocTraits::destroy(alloc_, blocks_[i / kBlockObjects] + i % kBlockObjects);
+        }
+
     public:
         // Delete the copy constructor--it does not typically make
         // sense under intended usage since the resulting copy will
@@ -79,14 +101,56 @@ namespace unc::robotics::mpt::impl {
         }
 
         ObjectPool(ObjectPool&& other)
-            : Base(std::move(other))
+            : alloc_(std::move(other.alloc_))
+            , blocks_(std::move(other.blocks_))
+            , size_(std::exchange(other.size_, 0))
         {
+            other.blocks_.clear();
+        }
+
+        ~ObjectPool() {
+            destroy();
+            for (T *block : blocks_)
+                AllocTraits::deallocate(alloc_, block, kBlockObjects);
+        }
+
+        // the number of objects allocated
+        std::size_t size() const {
+            return size_;
+        }
+
+        // the bytes of the blocks allocated, including the blocks
+        // retained by clear().
+        std::size_t bytes() const {
+            return blocks_.size() * kBlockObjects * sizeof(T);
+        }
+
+        // destroys all objects, but keeps the blocks for reuse.
+        void clear() {
+            destroy();
+            size_ = 0;
+        }
+
+        // the i-th object allocated, for i < size().
+        T& operator [] (std::size_t i) {
+            return blocks_[i / kBlockObjects][i % kBlockObjects];
+        }
+
+        const T& operator [] (std::size_t i) const {
+            return blocks_[i / kBlockObjects][i % kBlockObjects];
         }
 
         template <typename ... Args>
         T* allocate(Args&& ... args) {
-            Base::emplace_back(std::forward<Args>(args)...);
-            return &Base::back();
+            std::size_t b = size_ / kBlockObjects;
+            if (b == blocks_.size()) {
+                blocks_.reserve(b + 1);
+                blocks_.push_back(AllocTraits::allocate(alloc_, kBlockObjects));
+            }
+            T *p = blocks_[b] + size_ % kBlockObjects;
+            AllocTraits::construct(alloc_, p, std::forward<Args>(args)...);
+            ++size_;
+            return p;
         }
     };
 
@@ -95,6 +159,10 @@ namespace unc::robotics::mpt::impl {
     template <typename T, class Allocator>
     class ObjectPool<T, false, Allocator> : std::forward_list<T, Allocator> {
         using Base = std::forward_list<T, Allocator>;
+
+        // std::forward_list does not track its size
+        std::size_t size_{0};
+
     public:
         ObjectPool(const ObjectPool&) = delete;
 
@@ -103,12 +171,31 @@ namespace unc::robotics::mpt::impl {
 
         ObjectPool(ObjectPool&& other)
             : Base(std::move(other))
+            , size_(std::exchange(other.size_, 0))
         {
         }
 
+        // the number of objects allocated
+        std::size_t size() const {
+            return size_;
+        }
+
+        // the bytes of storage used by the allocated objects,
+        // including the list's link in each.
+        std::size_t bytes() const {
+            return size_ * (sizeof(T) + sizeof(void*));
+        }
+
+        // destroys and frees all objects.
+        void clear() {
+            Base::clear();
+            size_ = 0;
+        }
+
         template <typename ... Args>
         T* allocate(Args&& ... args) {
             Base::emplace_front(std::forward<Args>(args)...);
+            ++size_;
             return &Base::front();
         }
 
@@ -0,0 +1,186 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_OFFSET_PTR_HPP
+#define MPT_IMPL_OFFSET_PTR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace unc::robotics::mpt::impl {
+    // OffsetPtr and AtomicOffsetPtr are pointers that store the
+    // offset from their own address to the object they point to.
+    // When both the pointer and the object are in the same shared
+    // memory segment, the pointer remains valid in every process
+    // that maps the segment, regardless of the address at which it
+    // is mapped.  An offset of 0 represents nullptr, thus an
+    // OffsetPtr cannot point to itself.
+    //
+    // Since the value depends on the address of the pointer, neither
+    // type is copied by value.  Copying an OffsetPtr copies the
+    // address it points to.
+
+    template <typename T>
+    class OffsetPtr {
+        std::ptrdiff_t offset_{0};
+
+        static std::ptrdiff_t encode(const void *self, T *p) {
+            return p == nullptr ? 0 : reinterpret_cast<std::intptr_t>(p) - reinterpret_cast<std::intptr_t>(self);
+        }
+
+        T* decode() const {
+            return offset_ == 0 ? nullptr : reinterpret_cast<T*>(
+                reinterpret_cast<std::intptr_t>(this) + offset_);
+        }
+
+    public:
+        OffsetPtr(T *p = nullptr)
+            : offset_(encode(this, p))
+        {
+        }
+
+        OffsetPtr(const OffsetPtr& other)
+            : offset_(encode(this, other.get()))
+        {
+        }
+
+        OffsetPtr& operator = (const OffsetPtr& other) {
+            offset_ = encode(this, other.get());
+            return *this;
+        }
+
+        OffsetPtr& operator = (T *p) {
+            offset_ = encode(this, p);
+            return *this;
+        }
+
+        T* get() const {
+            return decode();
+        }
+
+        operator T* () const {
+            return decode();
+        }
+
+        T* operator -> () const {
+            return decode();
+        }
+    };
+
+    // AtomicOffsetPtr mirrors the subset of std::atomic<T*> used by
+    // the lock-free graph structures, so that they may swap one for
+    // the other.  The atomic operations are on the offset, which is
+    // lock-free across processes since std::atomic<std::ptrdiff_t>
+    // is address-free when lock-free.
+    template <typename T>
+    class AtomicOffsetPtr {
+        std::atomic<std::ptrdiff_t> offset_;
+
+        static_assert(std::atomic<std::ptrdiff_t>::is_always_lock_free,
+                      "offset pointers require lock-free atomics to be shared between processes");
+
+        std::ptrdiff_t encode(T *p) const {
+            return p == nullptr ? 0 : reinterpret_cast<std::intptr_t>(p) - reinterpret_cast<std::intptr_t>(this);
+        }
+
+        T* decode(std::ptrdiff_t offset) const {
+            return offset == 0 ? nullptr : reinterpret_cast<T*>(
+                reinterpret_cast<std::intptr_t>(this) + offset);
+        }
+
+    public:
+        AtomicOffsetPtr(T *p = nullptr)
+            : offset_(encode(p))
+        {
+        }
+
+        AtomicOffsetPtr(const AtomicOffsetPtr&) = delete;
+        AtomicOffsetPtr& operator = (const AtomicOffsetPtr&) = delete;
+
+        T* load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return decode(offset_.load(order));
+        }
+
+        void store(T *p, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            offset_.store(encode(p), order);
+        }
+
+        bool compare_exchange_weak(
+            T*& expected, T *desired,
+            std::memory_order success, std::memory_order failure) noexcept
+        {
+            std::ptrdiff_t e = encode(expected);
+            if (offset_.compare_exchange_weak(e, encode(desired), success, failure))
+                return true;
+            expected = decode(e);
+            return false;
+        }
+
+        bool compare_exchange_strong(
+            T*& expected, T *desired,
+            std::memory_order success, std::memory_order failure) noexcept
+        {
+            std::ptrdiff_t e = encode(expected);
+            if (offset_.compare_exchange_strong(e, encode(desired), success, failure))
+                return true;
+            expected = decode(e);
+            return false;
+        }
+
+        bool compare_exchange_strong(
+            T*& expected, T *desired,
+            std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return compare_exchange_strong(
+                expected, desired, order,
+                order == std::memory_order_acq_rel ? std::memory_order_acquire
+                : order == std::memory_order_release ? std::memory_order_relaxed
+                : order);
+        }
+    };
+
+    // Selects between raw and offset pointers for structures that
+    // may be placed in a shared memory segment.
+    template <typename T, bool shared>
+    using ptr_t = std::conditional_t<shared, OffsetPtr<T>, T*>;
+
+    template <typename T, bool shared>
+    using atomic_ptr_t = std::conditional_t<shared, AtomicOffsetPtr<T>, std::atomic<T*>>;
+}
+
+#endif
@@ -38,45 +38,36 @@
 #define MPT_IMPL_PLANNER_BASE_HPP
 
 #include <chrono>
-#include "condition_timer.hpp"
+#include "deadline_done_fn.hpp"
 
 namespace unc::robotics::mpt::impl {
     template <typename Derived>
     class PlannerBase {
     public:
-        // The time based solve methods use ConditionTimer instead of
-        // SleepTimer, since it is more well-behaved in the case when
-        // solve() terminates for a reason other than the doneFn
-        // predicate returning true (e.g., an exception)
-
-        // TODO: when solve(fn) is only going to call the done
-        // predicate a few times, it may be better to just call
-        // Clock::now() directly in the done predicate, instead of
-        // incurring the overhead of starting another thread just for
-        // the conditioned timed wait.
+        // The time based solve methods check the clock from the done
+        // predicate (see DeadlineDoneFn), instead of starting a
+        // thread to wait on the deadline.  The clock is only read
+        // every few calls, with the number of calls adapted to the
+        // time each iteration takes.
 
         template <typename Rep, typename Period>
         void solveFor(const std::chrono::duration<Rep, Period>& duration) {
-            ConditionTimer timer(duration);
-            static_cast<Derived*>(this)->solve(timer.doneFn());
+            solveUntil(std::chrono::steady_clock::now() + duration);
         }
 
         template <class Clock, class Duration>
         void solveUntil(const std::chrono::time_point<Clock, Duration>& endTime) {
-            ConditionTimer timer(endTime);
-            static_cast<Derived*>(this)->solve(timer.doneFn());
+            static_cast<Derived*>(this)->solve(deadlineDoneFn(endTime));
         }
 
         template <typename DoneFn, typename Rep, typename Period>
         void solveFor(DoneFn doneFn, const std::chrono::duration<Rep, Period>& duration) {
-            ConditionTimer timer(duration);
-            static_cast<Derived*>(this)->solve(timer.doneFn(doneFn));
+            solveUntil(std::move(doneFn), std::chrono::steady_clock::now() + duration);
         }
 
         template <typename DoneFn, class Clock, class Duration>
         void solveUntil(DoneFn doneFn, const std::chrono::time_point<Clock, Duration>& endTime) {
-            ConditionTimer timer(endTime);
-            static_cast<Derived*>(this)->solve(timer.doneFn(doneFn));
+            static_cast<Derived*>(this)->solve(deadlineDoneFn(endTime, std::move(doneFn)));
         }
     };
 }
@@ -0,0 +1,114 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_POOL_STRATEGY_HPP
+#define MPT_IMPL_POOL_STRATEGY_HPP
+
+#include "arena_pool.hpp"
+#include "compact_heap.hpp"
+#include "object_pool.hpp"
+#include "packs.hpp"
+#include "../planner_tags.hpp"
+#include <memory>
+#include <type_traits>
+
+namespace unc::robotics::mpt::impl {
+    // rebinds an allocator to allocate objects of type T.
+    template <typename Allocator, typename T>
+    using rebind_alloc_t = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    template <typename T>
+    struct is_allocator_tag : std::false_type {};
+
+    template <typename A>
+    struct is_allocator_tag<allocator<A>> : std::true_type {};
+
+    // pack_allocator_t<Options...> is the allocator configured with
+    // an allocator<A> tag, or std::allocator when there is none.
+    template <typename ... Options>
+    using pack_allocator_t = typename pack_find_t<
+        is_allocator_tag, allocator<std::allocator<char>>, Options...>::type;
+
+    template <typename T>
+    struct is_pool_strategy : std::false_type {};
+
+    template <std::size_t blockSize, bool hugePages>
+    struct is_pool_strategy<arena_pool<blockSize, hugePages>> : std::true_type {};
+
+    template <>
+    struct is_pool_strategy<compact_graph> : std::true_type {};
+
+    // true when the pool strategy places objects in the CompactHeap,
+    // thus the graph may link them with CompactPtrs.
+    template <typename PoolStrategy>
+    constexpr bool is_compact_v = std::is_same_v<PoolStrategy, compact_graph>;
+
+    // pool_strategy<T, PoolStrategy> selects the pool that a planner
+    // allocates its graph's objects of type T from.  PoolStrategy is
+    // the configured pool tag (void = the default ObjectPool), and
+    // Allocator is the configured allocator, which the pool rebinds
+    // to allocate its storage.
+    template <typename T, typename PoolStrategy, typename Allocator = std::allocator<T>>
+    struct pool_strategy {
+        using type = ObjectPool<T, true, rebind_alloc_t<Allocator, T>>;
+    };
+
+    template <typename T, std::size_t blockSize, bool hugePages, typename Allocator>
+    struct pool_strategy<T, arena_pool<blockSize, hugePages>, Allocator> {
+        using type = ArenaPool<T, blockSize, hugePages, rebind_alloc_t<Allocator, T>>;
+    };
+
+    template <typename T, typename Allocator>
+    struct pool_strategy<T, compact_graph, Allocator> {
+        using type = CompactPool<T>;
+    };
+
+    template <typename T, typename PoolStrategy, typename Allocator = std::allocator<T>>
+    using pool_strategy_t = typename pool_strategy<T, PoolStrategy, Allocator>::type;
+
+    // start_pool_t<T, PoolStrategy, Allocator> selects the pool for
+    // the few objects the planner creates for its start states.  It
+    // is a non-thread-safe ObjectPool, unless the graph is compact,
+    // in which case the start objects must be in the CompactHeap as
+    // well.
+    template <typename T, typename PoolStrategy, typename Allocator = std::allocator<T>>
+    using start_pool_t = std::conditional_t<
+        is_compact_v<PoolStrategy>,
+        CompactPool<T>,
+        ObjectPool<T, false, rebind_alloc_t<Allocator, T>>>;
+}
+
+#endif
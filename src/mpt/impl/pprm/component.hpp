@@ -37,65 +37,189 @@
 #ifndef MPT_IMPL_PPRM_COMPONENT_HPP
 #define MPT_IMPL_PPRM_COMPONENT_HPP
 
+#include "../cas_stat.hpp"
 #include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <utility>
 
 namespace unc::robotics::mpt::impl::pprm {
-    struct Component {
+    struct ComponentFlags {
         enum Flags : unsigned char {
             kNone = 0,
             kStart = 1,
             kGoal = 2,
             kSolution = kStart | kGoal
         };
+    };
 
-        std::size_t size_;
-        Flags flags_;
-        std::atomic<Component*> next_{nullptr};
+    // Each node embeds a Component, which makes the node an element
+    // of a lock-free union-find over the roadmap's connected
+    // components.  A component is identified by its root element,
+    // which tracks the component's size and whether it contains a
+    // start and/or goal.
+    //
+    // The state of an element is a single atomic word.  A root
+    // stores (size << 3 | flags << 1 | 1), and any other element
+    // stores the offset from itself to its parent.  Since elements
+    // are 8-byte aligned, offsets always have a 0 low bit.  Offsets
+    // do not depend on where the roadmap is mapped, thus the same
+    // representation works in a SharedSegment.
+    //
+    // merge() links the root of the smaller component under the
+    // root of the larger (union by size), with a CAS on the smaller
+    // root's word, and then adds its size and flags to the larger.
+    // Ties are broken by address.  Since sizes only grow and the CAS
+    // validates the size of the root being linked, two concurrent
+    // merges cannot link roots under each other.  find() halves the
+    // path as it goes, thus the depth stays constant amortized.
+    class Component : public ComponentFlags {
+        static constexpr std::uint64_t kRootBit = 1;
 
-    public:
-        inline Component(std::size_t size, Flags flags)
-            : size_(size), flags_(flags)
-        {
+        std::atomic<std::uint64_t> word_;
+
+        static constexpr std::uint64_t rootWord(std::uint64_t size, unsigned flags) {
+            return (size << 3) | (flags << 1) | kRootBit;
         }
 
-        inline Component(Component *a, Component *b) {
-            update(a, b);
+        static constexpr bool isRoot(std::uint64_t w) {
+            return (w & kRootBit) != 0;
         }
 
-        std::size_t size() const {
-            return size_;
+        static constexpr std::uint64_t sizeOf(std::uint64_t w) {
+            return w >> 3;
+        }
+
+        static constexpr Flags flagsOf(std::uint64_t w) {
+            return static_cast<Flags>((w >> 1) & kSolution);
+        }
+
+        std::uint64_t parentWord(const Component *parent) const {
+            return reinterpret_cast<std::uintptr_t>(parent) - reinterpret_cast<std::uintptr_t>(this);
+        }
+
+        Component* parent(std::uint64_t w) const {
+            assert(!isRoot(w));
+            return reinterpret_cast<Component*>(reinterpret_cast<std::uintptr_t>(this) + w);
         }
 
-        inline void update(Component *a, Component *b) {
-            size_ = a->size_ + b->size_;
-            flags_ = static_cast<Flags>(a->flags_ | b->flags_);
+        // the word of this element's root.  Unlike find(), this
+        // does not modify the path.
+        std::uint64_t loadRoot() const {
+            const Component *x = this;
+            for (;;) {
+                std::uint64_t w = x->word_.load(std::memory_order_acquire);
+                if (isRoot(w))
+                    return w;
+                x = x->parent(w);
+            }
         }
 
-        inline Component *next() {
-            Component *next = next_.load(std::memory_order_acquire);
-            if (next != nullptr) {
-                if (Component *n = next->next()) {
-                    next_.compare_exchange_strong(next, n, std::memory_order_relaxed);
-                    return n;
+        // adds the size and flags of a root word that was just linked
+        // under r to the root of r's component, and returns that
+        // root.
+        static Component* addToRoot(Component *r, std::uint64_t child, unsigned& retries) {
+            std::uint64_t w = r->word_.load(std::memory_order_acquire);
+            for (;;) {
+                if (!isRoot(w)) {
+                    // r was linked under another root since it was
+                    // found.  That merge did not include child, so
+                    // follow it.
+                    r = r->parent(w);
+                    w = r->word_.load(std::memory_order_acquire);
+                } else if (r->word_.compare_exchange_weak(
+                               w, rootWord(sizeOf(w) + sizeOf(child), flagsOf(w) | flagsOf(child)),
+                               std::memory_order_acq_rel,
+                               std::memory_order_acquire)) {
+                    return r;
+                } else {
+                    ++retries;
                 }
             }
-            return next;
         }
 
-        inline bool casNext(Component*& expect, Component *value, std::memory_order order) {
-            return next_.compare_exchange_strong(expect, value, order);
+    public:
+        Component(const Component&) = delete;
+
+        explicit Component(Flags flags)
+            : word_(rootWord(1, flags))
+        {
+        }
+
+        // the root of this element's component.
+        Component* find() {
+            Component *x = this;
+            for (;;) {
+                std::uint64_t wx = x->word_.load(std::memory_order_acquire);
+                if (isRoot(wx))
+                    return x;
+                Component *p = x->parent(wx);
+                std::uint64_t wp = p->word_.load(std::memory_order_acquire);
+                if (isRoot(wp))
+                    return p;
+                // path halving: point x at its grandparent, and
+                // continue from there.  If the CAS fails, another
+                // thread has already shortened the path.
+                Component *g = p->parent(wp);
+                x->word_.compare_exchange_weak(
+                    wx, x->parentWord(g), std::memory_order_release, std::memory_order_relaxed);
+                x = g;
+            }
+        }
+
+        // Merges the components of a and b, and returns the root of
+        // the merged component.  The number of CAS retries is
+        // counted in stat.
+        template <bool enableStat = false>
+        static Component* merge(Component *a, Component *b, CASStat<enableStat>& stat = CASStat<false>::instance()) {
+            unsigned retries = 0;
+            for (;;) {
+                a = a->find();
+                b = b->find();
+                if (a == b)
+                    break;
+
+                std::uint64_t wa = a->word_.load(std::memory_order_acquire);
+                std::uint64_t wb = b->word_.load(std::memory_order_acquire);
+                if (!isRoot(wa) || !isRoot(wb)) {
+                    ++retries;
+                    continue;
+                }
+
+                if (sizeOf(wb) < sizeOf(wa) || (sizeOf(wb) == sizeOf(wa) && std::less<Component*>()(b, a))) {
+                    std::swap(a, b);
+                    std::swap(wa, wb);
+                }
+
+                if (!a->word_.compare_exchange_strong(
+                        wa, a->parentWord(b), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    ++retries;
+                    continue;
+                }
+
+                b = addToRoot(b, wa, retries);
+                break;
+            }
+            stat += retries;
+            return b;
+        }
+
+        // the number of nodes in this element's component.
+        std::size_t size() const {
+            return sizeOf(loadRoot());
         }
 
-        inline bool isGoal() {
-            return (flags_ & kGoal) != 0;
+        bool isGoal() const {
+            return (flagsOf(loadRoot()) & kGoal) != 0;
         }
 
-        inline bool isStart() {
-            return (flags_ & kStart) != 0;
+        bool isStart() const {
+            return (flagsOf(loadRoot()) & kStart) != 0;
         }
 
-        inline bool isSolution() {
-            return flags_ == kSolution;
+        bool isSolution() const {
+            return flagsOf(loadRoot()) == kSolution;
         }
     };
 }
@@ -0,0 +1,195 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_PPRM_CSR_GRAPH_HPP
+#define MPT_IMPL_PPRM_CSR_GRAPH_HPP
+
+#include "../pool_strategy.hpp"
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace unc::robotics::mpt::impl::pprm {
+    // A CSRGraph is a frozen copy of a roadmap's adjacency in
+    // compressed sparse row form.  Nodes are numbered contiguously,
+    // the edges out of node i are targets_[offsets_[i]] through
+    // targets_[offsets_[i+1]-1], and each edge's cost is stored
+    // alongside its target.  Unlike the roadmap's edge lists, which
+    // are scattered across the workers' pools, a row is contiguous,
+    // thus a shortest path search reads the adjacency sequentially
+    // instead of chasing a pointer per edge, and does not need to
+    // recompute edge costs from states.
+    template <typename Node, typename Distance, typename Allocator>
+    class CSRGraph {
+        template <typename T>
+        using Vector = std::vector<T, rebind_alloc_t<Allocator, T>>;
+
+        static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+        Vector<const Node*> nodes_;
+        Vector<std::uint32_t> offsets_;
+        Vector<std::uint32_t> targets_;
+        Vector<Distance> costs_;
+        Vector<std::uint8_t> goals_;
+        Vector<std::uint32_t> starts_;
+
+    public:
+        bool empty() const {
+            return nodes_.empty();
+        }
+
+        // the number of nodes
+        std::size_t size() const {
+            return nodes_.size();
+        }
+
+        // the number of directed edges (two per roadmap connection)
+        std::size_t edgeCount() const {
+            return targets_.size();
+        }
+
+        const Node* node(std::uint32_t id) const {
+            return nodes_[id];
+        }
+
+        std::size_t bytes() const {
+            return nodes_.capacity() * sizeof(const Node*)
+                + offsets_.capacity() * sizeof(std::uint32_t)
+                + targets_.capacity() * sizeof(std::uint32_t)
+                + costs_.capacity() * sizeof(Distance)
+                + goals_.capacity() * sizeof(std::uint8_t)
+                + starts_.capacity() * sizeof(std::uint32_t);
+        }
+
+        // removes the graph, keeping the storage for the next
+        // build().
+        void clear() {
+            nodes_.clear();
+            offsets_.clear();
+            targets_.clear();
+            costs_.clear();
+            goals_.clear();
+            starts_.clear();
+        }
+
+        // Builds the graph from the roadmap.  forEachNode(fn) must
+        // call fn on every node of the roadmap, which are numbered in
+        // the order visited.  starts are the nodes the search in
+        // shortestPath() begins from.  The roadmap must not change
+        // while building.
+        template <typename ForEachNode, typename Starts>
+        void build(ForEachNode&& forEachNode, const Starts& starts) {
+            clear();
+
+            std::unordered_map<
+                const Node*, std::uint32_t, std::hash<const Node*>, std::equal_to<const Node*>,
+                rebind_alloc_t<Allocator, std::pair<const Node* const, std::uint32_t>>> ids;
+
+            forEachNode([&] (const Node *n) {
+                ids.emplace(n, static_cast<std::uint32_t>(nodes_.size()));
+                nodes_.push_back(n);
+            });
+
+            offsets_.reserve(nodes_.size() + 1);
+            goals_.reserve(nodes_.size());
+            offsets_.push_back(0);
+            for (const Node *n : nodes_) {
+                for (auto *e = n->edges() ; e ; e = e->next(n)) {
+                    targets_.push_back(ids.at(e->to(n)));
+                    costs_.push_back(e->distance());
+                }
+                offsets_.push_back(static_cast<std::uint32_t>(targets_.size()));
+                goals_.push_back(n->goal());
+            }
+
+            for (const Node *s : starts)
+                starts_.push_back(ids.at(s));
+        }
+
+        // Finds the shortest path from the start nodes to the nearest
+        // goal node with Dijkstra's algorithm.  path is set to the
+        // node ids of the path from start to goal, or left empty when
+        // no goal is reachable.
+        template <typename Path>
+        void shortestPath(Path& path) const {
+            path.clear();
+            std::size_t n = nodes_.size();
+            Vector<Distance> dist(n, std::numeric_limits<Distance>::infinity());
+            Vector<std::uint32_t> parent(n, kNone);
+
+            using QItem = std::pair<Distance, std::uint32_t>;
+            std::priority_queue<QItem, Vector<QItem>, std::greater<QItem>> q;
+
+            for (std::uint32_t s : starts_) {
+                dist[s] = 0;
+                q.emplace(Distance(0), s);
+            }
+
+            while (!q.empty()) {
+                auto [ d, u ] = q.top();
+                q.pop();
+
+                // already popped
+                if (dist[u] < d)
+                    continue;
+
+                if (goals_[u]) {
+                    for (std::uint32_t v = u ; v != kNone ; v = parent[v])
+                        path.push_back(v);
+                    std::reverse(path.begin(), path.end());
+                    return;
+                }
+
+                for (std::uint32_t e = offsets_[u], end = offsets_[u+1] ; e < end ; ++e) {
+                    std::uint32_t v = targets_[e];
+                    Distance dv = d + costs_[e];
+                    if (dv < dist[v]) {
+                        dist[v] = dv;
+                        parent[v] = u;
+                        q.emplace(dv, v);
+                    }
+                }
+            }
+        }
+    };
+}
+
+#endif
@@ -37,38 +37,162 @@
 #ifndef MPT_IMPL_PPRM_EDGE_HPP
 #define MPT_IMPL_PPRM_EDGE_HPP
 
+#include "../compact_ptr.hpp"
+#include "../offset_ptr.hpp"
 #include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
 
 namespace unc::robotics::mpt::impl::pprm {
-    template <typename State, typename Distance>
+    template <typename State, typename Distance, bool shared, bool compact>
     class Node;
 
-    template <typename State, typename Distance>
+    // The validation status of an edge.  Edges added by the planner
+    // are currently validated before they are added, thus are kValid.
+    // A lazy mode may instead add edges as kUnchecked, and check them
+    // when a path uses them.
+    enum class EdgeStatus : std::uint8_t {
+        kValid = 0,
+        kUnchecked = 1,
+        kInvalid = 2,
+    };
+
+    // EdgeEnds stores both endpoints of an edge in a single word as
+    // the xor of their offsets from the edge, from which either
+    // endpoint is recovered given the other.  The offsets do not
+    // depend on where the roadmap is mapped, thus the same encoding
+    // works for edges in a SharedSegment.  Since nodes and edges are
+    // at least 8-byte aligned, the low bits of the xor are always 0,
+    // and hold the edge's status instead.
+    template <bool compact>
+    class EdgeEnds {
+        static constexpr std::uintptr_t kStatusMask = 3;
+
+        std::atomic<std::uintptr_t> ends_;
+
+        static std::uintptr_t offset(const void *self, const void *p) {
+            return reinterpret_cast<std::uintptr_t>(p) - reinterpret_cast<std::uintptr_t>(self);
+        }
+
+    public:
+        EdgeEnds(const void *self, const void *a, const void *b, EdgeStatus status)
+            : ends_((offset(self, a) ^ offset(self, b)) | static_cast<std::uintptr_t>(status))
+        {
+            assert(((offset(self, a) | offset(self, b)) & kStatusMask) == 0);
+        }
+
+        template <typename T>
+        T* other(const void *self, const T *from) const {
+            std::uintptr_t x = ends_.load(std::memory_order_relaxed) & ~kStatusMask;
+            return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(self) + (x ^ offset(self, from)));
+        }
+
+        EdgeStatus status(std::memory_order order) const {
+            return static_cast<EdgeStatus>(ends_.load(order) & kStatusMask);
+        }
+
+        bool casStatus(EdgeStatus expect, EdgeStatus value, std::memory_order success, std::memory_order failure) {
+            std::uintptr_t e = ends_.load(std::memory_order_relaxed);
+            e = (e & ~kStatusMask) | static_cast<std::uintptr_t>(expect);
+            return ends_.compare_exchange_strong(
+                e, (e & ~kStatusMask) | static_cast<std::uintptr_t>(value), success, failure);
+        }
+    };
+
+    // With a compact graph, the endpoints are the xor of their
+    // 32-bit CompactHeap indices, which uses all the bits of the
+    // index, thus the status is stored apart.
+    template <>
+    class EdgeEnds<true> {
+        std::uint32_t ends_;
+        std::atomic<EdgeStatus> status_;
+
+    public:
+        EdgeEnds(const void *, const void *a, const void *b, EdgeStatus status)
+            : ends_(CompactHeap::encode(a) ^ CompactHeap::encode(b))
+            , status_(status)
+        {
+        }
+
+        template <typename T>
+        T* other(const void *, const T *from) const {
+            return CompactHeap::decode<T>(ends_ ^ CompactHeap::encode(from));
+        }
+
+        EdgeStatus status(std::memory_order order) const {
+            return status_.load(order);
+        }
+
+        bool casStatus(EdgeStatus expect, EdgeStatus value, std::memory_order success, std::memory_order failure) {
+            return status_.compare_exchange_strong(expect, value, success, failure);
+        }
+    };
+
+    // An undirected edge of the roadmap.  A single edge record is
+    // shared by both endpoints, and is linked into both of their edge
+    // lists, thus it has a next pointer for each endpoint's list.
+    // The endpoint with the lower address uses next_[0], and the
+    // other uses next_[1].  (Within a SharedSegment, the order of
+    // addresses is the same in every process.)  Thus traversing a
+    // list requires the node that the list belongs to:
+    //
+    //     for (const Edge *e = n->edges() ; e ; e = e->next(n))
+    //         visit(e->to(n));
+    //
+    // Edges link with offset pointers when shared, and with 32-bit
+    // CompactPtrs when compact.
+    template <typename State, typename Distance, bool shared = false, bool compact = false>
     class Edge {
-        Node<State, Distance> *to_;
+        using Node = pprm::Node<State, Distance, shared, compact>;
+        using EdgePtr = std::conditional_t<compact, AtomicCompactPtr<Edge>, atomic_ptr_t<Edge, shared>>;
+
+        EdgeEnds<compact> ends_;
         Distance distance_;
-        std::atomic<Edge*> next_;
+        EdgePtr next_[2];
+
+        int side(const Node *from) const {
+            return std::less<const Node*>()(from, to(from)) ? 0 : 1;
+        }
 
     public:
-        Edge(Node<State, Distance>* to, Distance dist)
-            : to_(to)
+        Edge(Node *a, Node *b, Distance dist, EdgeStatus status = EdgeStatus::kValid)
+            : ends_(this, a, b, status)
             , distance_(dist)
         {
+            assert(a != b);
         }
 
-        void setNext(Edge* next, std::memory_order order) {
-            next_.store(next, order);
+        // sets the next edge in from's edge list.
+        void setNext(const Node *from, Edge* next, std::memory_order order) {
+            next_[side(from)].store(next, order);
         }
 
-        const Node<State, Distance>* to() const {
-            return to_;
+        // the endpoint of this edge that is not from.
+        const Node* to(const Node *from) const {
+            return ends_.other(this, from);
         }
 
-        const Edge* next() const {
-            return next_.load(std::memory_order_acquire);
+        // the next edge in from's edge list.
+        const Edge* next(const Node *from) const {
+            return next_[side(from)].load(std::memory_order_acquire);
+        }
+
+        Distance distance() const {
+            return distance_;
+        }
+
+        EdgeStatus status(std::memory_order order = std::memory_order_acquire) const {
+            return ends_.status(order);
+        }
+
+        // updates the status from expect to value, returning false if
+        // another thread updated it first.
+        bool casStatus(EdgeStatus expect, EdgeStatus value) {
+            return ends_.casStatus(expect, value, std::memory_order_release, std::memory_order_relaxed);
         }
     };
 }
 
 #endif
-
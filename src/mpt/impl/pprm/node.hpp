@@ -37,23 +37,40 @@
 #ifndef MPT_IMPL_PPRM_NODE_HPP
 #define MPT_IMPL_PPRM_NODE_HPP
 
+#include "component.hpp"
+#include "../cas_stat.hpp"
+#include "../compact_ptr.hpp"
+#include "../offset_ptr.hpp"
 #include <atomic>
 
 namespace unc::robotics::mpt::impl::pprm {
-    template <typename State, typename Distance>
+    template <typename State, typename Distance, bool shared, bool compact>
     class Edge;
 
-    template <typename State, typename Distance>
+    // when shared is true, the node is allocated in a SharedSegment,
+    // and thus links to its edges with offset pointers (its embedded
+    // Component is position independent).  In this case, State must
+    // not own memory outside of the node (e.g., a fixed-size Eigen
+    // vector).  When compact is
+    // true, the node links to its edges with a 32-bit CompactPtr, and
+    // nodes and edges must be allocated from CompactPools.
+    template <typename State, typename Distance, bool shared = false, bool compact = false>
     class Node {
+        static_assert(!(shared && compact), "compact nodes cannot be shared");
+
+        using Edge = pprm::Edge<State, Distance, shared, compact>;
         State state_;
-        std::atomic<Component*> component_;
-        std::atomic<Edge<State,Distance>*> edges_;
+        Component component_;
+        std::conditional_t<compact, AtomicCompactPtr<Edge>, atomic_ptr_t<Edge, shared>> edges_;
+        bool goal_;
+        bool exact_{false};
     public:
         template <typename ... Args>
-        Node(Component *component, Args&& ... args)
+        Node(ComponentFlags::Flags flags, bool goal, Args&& ... args)
             : state_(std::forward<Args>(args)...)
-            , component_(component)
+            , component_(flags)
             , edges_(nullptr)
+            , goal_(goal)
         {
         }
 
@@ -61,37 +78,68 @@ namespace unc::robotics::mpt::impl::pprm {
             return state_;
         }
 
-        const Edge<State, Distance>* edges() const {
+        bool goal() const {
+            return goal_;
+        }
+
+        // true when the planner keeps the exact state of this node
+        // (a start or goal), of which state() is the quantized
+        // encoding.
+        bool exact() const {
+            return exact_;
+        }
+
+        void setExact() {
+            exact_ = true;
+        }
+
+        const Edge* edges() const {
             return edges_.load(std::memory_order_acquire);
         }
 
+        // the root of the node's component.
         Component* component() {
-            Component *c = component_.load(std::memory_order_relaxed);
-            if (Component *n = c->next()) {
-                component_.compare_exchange_strong(c, n, std::memory_order_relaxed);
-                return n;
-            }
-            return c;
+            return component_.find();
         }
 
-        Component* addEdge(Edge<State, Distance> *edge) {
-            Edge<State, Distance> *head = edges_.load(std::memory_order_relaxed);
-            do {
-                edge->setNext(head, std::memory_order_relaxed);
-            } while (edges_.compare_exchange_weak(
-                         head, edge,
-                         std::memory_order_release,
-                         std::memory_order_relaxed));
+        // Adds the edge to this node's edge list, counting the
+        // number of CAS retries in stat.
+        template <bool enableStat = false>
+        Component* addEdge(Edge *edge, CASStat<enableStat>& stat = CASStat<false>::instance()) {
+            unsigned retries = 0;
+            Edge *head = edges_.load(std::memory_order_relaxed);
+            for (;;) {
+                edge->setNext(this, head, std::memory_order_relaxed);
+                if (edges_.compare_exchange_weak(
+                        head, edge,
+                        std::memory_order_release,
+                        std::memory_order_relaxed))
+                    break;
+                ++retries;
+            }
+            stat += retries;
             return component();
         }
     };
 
     struct NodeKey {
-        template <typename State, typename Distance>
-        const State& operator() (const Node<State, Distance>* n) const {
+        template <typename State, typename Distance, bool shared, bool compact>
+        const State& operator() (const Node<State, Distance, shared, compact>* n) const {
             return n->state();
         }
     };
+
+    // the key for nodes that store encoded states, which decodes the
+    // state with the codec.
+    template <typename Codec>
+    struct DecodingNodeKey {
+        Codec codec_;
+
+        template <typename Encoded, typename Distance, bool shared, bool compact>
+        typename Codec::Type operator() (const Node<Encoded, Distance, shared, compact>* n) const {
+            return codec_.decode(n->state());
+        }
+    };
 }
 
 #endif
@@ -38,59 +38,284 @@
 #define MPT_IMPL_PPRM_PLANNER_HPP
 
 #include "component.hpp"
+#include "csr_graph.hpp"
 #include "node.hpp"
 #include "edge.hpp"
+#include "../cas_stat.hpp"
+#include "../goal_list.hpp"
 #include "../planner_base.hpp"
+#include "../memory_budget.hpp"
+#include "../memory_stats.hpp"
+#include "../pool_strategy.hpp"
 #include "../scenario_space.hpp"
+#include "../scenario_valid_batch.hpp"
 #include "../scenario_rng.hpp"
 #include "../scenario_sampler.hpp"
+#include "../scenario_shared.hpp"
+#include "../scenario_bounds.hpp"
 #include "../scenario_goal.hpp"
 #include "../goal_has_sampler.hpp"
 #include "../worker_pool.hpp"
+#include "../worker_seed.hpp"
 #include "../object_pool.hpp"
+#include "../segment_pool.hpp"
+#include "../../fixed_seed.hpp"
 #include "../../goal_sampler.hpp"
 #include "../../random_device_seed.hpp"
+#include "../../state_codec.hpp"
+#include <algorithm>
 #include <mutex>
 #include <atomic>
 #include <forward_list>
-#include <set>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <stdexcept>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace unc::robotics::mpt::impl::pprm {
 
-    template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy>
-    class PPRM : public PlannerBase<PPRM<Scenario, maxThreads, reportStats, NNStrategy>> {
+    template <bool enable>
+    struct WorkerStats;
+
+    template <>
+    struct WorkerStats<false> {
+        void countIteration() const {}
+        auto& addEdgeCAS() { return CASStat<false>::instance(); }
+        auto& mergeCAS() { return CASStat<false>::instance(); }
+    };
+
+    template <>
+    struct WorkerStats<true> {
+        mutable std::size_t iterations_{0};
+        mutable CASStat<> addEdgeCAS_;
+        mutable CASStat<> mergeCAS_;
+
+        void countIteration() const { ++iterations_; }
+        CASStat<>& addEdgeCAS() const { return addEdgeCAS_; }
+        CASStat<>& mergeCAS() const { return mergeCAS_; }
+
+        WorkerStats& operator += (const WorkerStats& other) {
+            iterations_ += other.iterations_;
+            addEdgeCAS_ += other.addEdgeCAS_;
+            mergeCAS_ += other.mergeCAS_;
+            return *this;
+        }
+
+        void print() const {
+            MPT_LOG(INFO) << "iterations: " << iterations_;
+            MPT_LOG(INFO) << "add edge CAS: " << addEdgeCAS_;
+            MPT_LOG(INFO) << "merge CAS: " << mergeCAS_;
+        }
+    };
+
+    template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy, bool deterministic,
+              bool shared, int sampleBatch, bool quantized, typename PoolStrategy, typename Allocator,
+              std::size_t memoryBudget>
+    class PPRM : public PlannerBase<PPRM<
+        Scenario, maxThreads, reportStats, NNStrategy, deterministic, shared, sampleBatch, quantized,
+        PoolStrategy, Allocator, memoryBudget>>
+    {
         using Planner = PPRM;
         using Base = PlannerBase<PPRM>;
         using Space = scenario_space_t<Scenario>;
         using State = typename Space::Type;
         using Distance = typename Space::Distance;
-        using Node = pprm::Node<State, Distance>;
-        using Edge = pprm::Edge<State, Distance>;
+
+        // with quantized states, nodes store their states encoded by
+        // the codec, and the states are decoded on access.
+        using Codec = std::conditional_t<quantized, StateCodec<Space, scenario_bounds_t<Scenario>>, void>;
+        using Stored = codec_encoded_t<Codec, State>;
+
+        // compact graphs require the CompactHeap, thus are not
+        // supported with shared roadmaps.
+        static constexpr bool compactGraph = !shared && is_compact_v<PoolStrategy>;
+        using Node = pprm::Node<Stored, Distance, shared, compactGraph>;
+        using Edge = pprm::Edge<Stored, Distance, shared, compactGraph>;
+        using Component = pprm::Component;
         using RNG = scenario_rng_t<Scenario, Distance>;
         using Sampler = scenario_sampler_t<Scenario, RNG>;
 
+        // the configured allocator, rebound to each type allocated
+        template <typename T>
+        using Alloc = rebind_alloc_t<Allocator, T>;
+        template <typename T>
+        using Vector = std::vector<T, Alloc<T>>;
+
+        // the pool type for objects in the roadmap.
+        template <typename T>
+        using Pool = std::conditional_t<shared, SegmentPool<T>, pool_strategy_t<T, PoolStrategy, Allocator>>;
+
+        std::conditional_t<quantized, Codec, std::nullptr_t> codec_;
+
+        using Key = std::conditional_t<quantized, DecodingNodeKey<Codec>, NodeKey>;
         using NNConcurrency = std::conditional_t<maxThreads == 1, nigh::NoThreadSafety, nigh::Concurrent>;
-        nigh::Nigh<Node*, Space, NodeKey, NNConcurrency, NNStrategy> nn_;
+        nigh::Nigh<Node*, Space, Key, NNConcurrency, NNStrategy, Alloc<Node*>> nn_;
 
         struct Worker;
 
-        WorkerPool<Worker, maxThreads> workers_;
-        std::atomic_bool solved_;
+        WorkerPool<Worker, maxThreads, Alloc<Worker>> workers_;
+        std::atomic_bool solved_{false};
+
+        // a shared roadmap is bounded by its segment instead.
+        MemoryBudget<shared ? 0 : memoryBudget> budget_;
 
         Distance kRRG_;
 
         std::mutex mutex_;
-        std::forward_list<Node*> startNodes_;
-        std::set<const Node*> goalNodes_;
+        std::forward_list<Node*, Alloc<Node*>> startNodes_;
+
+        // with quantized states, start and goal nodes keep their
+        // exact states, from which their motions are checked, and
+        // which state() returns in place of the decoded state.  Thus
+        // solutions begin and end exactly at the start and goal.
+        // With a shared roadmap, the exact states are allocated in
+        // the segment and recorded on its kExactRoot list, so that
+        // every process sees them.
+        struct ExactState {
+            ptr_t<const Node, shared> node_;
+            State state_;
+
+            ExactState(const Node *node, const State& state)
+                : node_(node)
+                , state_(state)
+            {
+            }
+        };
+        std::forward_list<ExactState, Alloc<ExactState>> exactStates_;
+
+        // goal nodes are recorded on a lock-free list so that workers
+        // do not serialize on a mutex when the goal region is large.
+        // The cost of a path to a goal is not known until the graph
+        // is searched, so the goals are all recorded with 0 cost, and
+        // solution() identifies goals by the flag on the node.
+        // (With a shared roadmap, goal records remain local to the
+        // process, and are the only way to identify its goals.)
+        using Goals = GoalList<Node, Distance, maxThreads != 1>;
+        using GoalRecord = typename Goals::Goal;
+        Goals goals_;
+
+        // the roadmap frozen by compact(), which solution() searches
+        // instead of the edge lists until the roadmap changes.
+        // Empty when the roadmap has not been compacted.
+        CSRGraph<Node, Distance, Allocator> csr_;
+
+        // With a shared roadmap, nodes are recorded on a root list of
+        // the segment, tagged with this planner's owner id.  imported_
+        // is the most recent record that has been added to nn_.
+        static constexpr unsigned kNodeRoot = 0;
+        static constexpr unsigned kExactRoot = 1;
+        SharedSegment *segment_{nullptr};
+        unsigned owner_{0};
+        std::uint64_t imported_{0};
+
+        // Adds the nodes recorded by other processes since the last
+        // import to the nearest neighbor index.  Nodes added by other
+        // processes while solving are not visible to this process
+        // until the next solve(), but edges and component merges
+        // made by other processes are visible immediately.
+        void importShared() {
+            std::uint64_t head = segment_->head(kNodeRoot);
+            std::size_t count = 0;
+            segment_->template forEach<Node>(
+                head, imported_,
+                [&] (Node *n, unsigned owner) {
+                    if (owner != owner_) {
+                        workers_[0].importNode(*this, n);
+                        ++count;
+                    }
+                });
+            imported_ = head;
+            MPT_LOG(DEBUG) << "imported " << count << " shared nodes";
+        }
+
+        // true if c is the component of one of this planner's starts.
+        bool isStartComponent(const Component *c) {
+            for (Node *s : startNodes_)
+                if (s->component() == c)
+                    return true;
+            return false;
+        }
+
+        // In a shared roadmap, the component flags include the starts
+        // and goals of every process, thus the planner is solved only
+        // once one of its own starts shares a component with one of
+        // its own goals.  This walks the goals, so workers only call
+        // it when a merge joins a start's component with a component
+        // that has a goal flag.
+        bool startConnectedToGoal() {
+            for (Node *s : startNodes_) {
+                Component *c = s->component();
+                for (const GoalRecord *g = goals_.head() ; g ; g = g->next())
+                    if (g->node()->component() == c)
+                        return true;
+            }
+            return false;
+        }
+
+        static auto makeCodec(const Scenario& scenario) {
+            if constexpr (!quantized)
+                return nullptr;
+            else if constexpr (scenario_has_bounds_v<Scenario>)
+                return Codec(scenario.space(), scenario.bounds());
+            else
+                return Codec(scenario.space(), Unbounded{});
+        }
+
+        Key nodeKey() const {
+            if constexpr (quantized)
+                return Key{codec_};
+            else
+                return Key{};
+        }
+
+        // returns the state of a node, decoding it if quantized.
+        decltype(auto) state(const Node *n) const {
+            if constexpr (quantized)
+                return n->exact() ? exactState(n) : codec_.decode(n->state());
+            else
+                return n->state();
+        }
+
+        // marks the node as having the exact state q.  Must be
+        // called before the node is linked into the roadmap.
+        void addExactState(Node *n, const State& q) {
+            n->setExact();
+            if constexpr (shared) {
+                segment_->record(kExactRoot, segment_->template construct<ExactState>(n, q), owner_);
+            } else {
+                std::lock_guard<std::mutex> lock(mutex_);
+                exactStates_.emplace_front(n, q);
+            }
+        }
 
-        void foundGoal(Node *node) {
-            // TODO: if there are a lot of goals, then this could
-            // become a concurrency bottleneck.  We can replace it
-            // with a lock-free linked list.
+        // the exact state of a node for which exact() is true.  There
+        // are only as many exact states as starts and goals, thus a
+        // linear search suffices.
+        const State& exactState(const Node *n) const {
+            const State *q = nullptr;
+            if constexpr (shared) {
+                segment_->template forEach<ExactState>(
+                    segment_->head(kExactRoot), 0,
+                    [&] (const ExactState *e, unsigned) {
+                        if (e->node_ == n)
+                            q = &e->state_;
+                    });
+            } else {
+                for (const ExactState& e : exactStates_)
+                    if (e.node_ == n)
+                        q = &e.state_;
+            }
+            assert(q != nullptr);
+            return *q;
+        }
+
+        void foundGoal(GoalRecord *goal) {
             MPT_LOG(TRACE) << "found goal";
-            std::lock_guard<std::mutex> lock(mutex_);
-            goalNodes_.insert(node);
+            goals_.push(goal);
         }
 
         void solutionFound() {
@@ -99,50 +324,169 @@ namespace unc::robotics::mpt::impl::pprm {
                 MPT_LOG(INFO) << "solution found";
         }
 
+        // solution() on the roadmap frozen by compact().
+        std::vector<State> compactSolution() const {
+            Vector<std::uint32_t> ids;
+            csr_.shortestPath(ids);
+
+            std::vector<State> path;
+            if (ids.empty())
+                return path;
+
+            path.reserve(ids.size());
+            for (std::uint32_t id : ids)
+                path.push_back(state(csr_.node(id)));
+            return path;
+        }
+
     public:
-        template <typename RNGSeed = RandomDeviceSeed<>>
+        template <typename RNGSeed = std::conditional_t<deterministic, FixedSeed, RandomDeviceSeed<>>>
         PPRM(const Scenario& scenario, const RNGSeed& seed = RNGSeed())
-            : nn_(scenario.space())
+            : codec_(makeCodec(scenario))
+            , nn_(scenario.space(), nodeKey())
             , workers_(scenario, seed)
             , kRRG_(E<Distance> + E<Distance> / scenario.space().dimensions())
         {
+            static_assert(!shared, "a shared roadmap must be constructed with a SharedSegment");
+            MPT_LOG(TRACE) << "Using nearest: " << log::type_name<NNStrategy>();
+            MPT_LOG(TRACE) << "Using sampler: " << log::type_name<Sampler>();
+        }
+
+        // Constructs a planner that builds its roadmap in a shared
+        // memory segment, and starts with the roadmap already in the
+        // segment.  The segment must outlive the planner.
+        template <typename RNGSeed = std::conditional_t<deterministic, FixedSeed, RandomDeviceSeed<>>>
+        PPRM(const Scenario& scenario, SharedSegment& segment, const RNGSeed& seed = RNGSeed())
+            : codec_(makeCodec(scenario))
+            , nn_(scenario.space(), nodeKey())
+            , workers_(scenario, seed, &segment)
+            , kRRG_(E<Distance> + E<Distance> / scenario.space().dimensions())
+            , segment_(&segment)
+            , owner_(segment.newOwner())
+        {
+            static_assert(shared, "a SharedSegment requires the shared_roadmap tag");
             MPT_LOG(TRACE) << "Using nearest: " << log::type_name<NNStrategy>();
             MPT_LOG(TRACE) << "Using sampler: " << log::type_name<Sampler>();
+            MPT_LOG(DEBUG) << "Using shared segment " << segment.name() << " as owner " << owner_;
+            importShared();
         }
 
         std::size_t size() const {
             return nn_.size();
         }
 
+        // Throws std::invalid_argument if the start state is not
+        // valid.
         template <typename ... Args>
         void addStart(Args&& ... args) {
-            Node *n = workers_[0].addSample(*this, State(std::forward<Args>(args)...), Component::kStart);
+            csr_.clear();
+            Node *n = workers_[0].addSample(*this, State(std::forward<Args>(args)...), ComponentFlags::kStart);
+            if (n == nullptr)
+                throw std::invalid_argument("start state is not valid");
 
             std::lock_guard<std::mutex> lock(mutex_);
             startNodes_.push_front(n);
         }
 
+        // Throws std::invalid_argument if the goal state is not
+        // valid.
         template <typename ... Args>
         void addGoal(Args&& ... args) {
-            workers_[0].addSample(*this, State(std::forward<Args>(args)...), Component::kGoal);
+            csr_.clear();
+            if (workers_[0].addSample(*this, State(std::forward<Args>(args)...), ComponentFlags::kGoal) == nullptr)
+                throw std::invalid_argument("goal state is not valid");
+        }
+
+        // Removes the roadmap, including the start and goal states, so
+        // that the planner can be reused for another problem.  Unlike
+        // constructing a new planner, the workers keep their scenario
+        // copies, random number generators, and the storage of their
+        // pools and buffers.  Worker stats are cleared.  Must not be
+        // called while solving.  A shared roadmap cannot be reset,
+        // since other processes may be using it.
+        void reset() {
+            static_assert(!shared, "a shared roadmap cannot be reset");
+            nn_.clear();
+            solved_.store(false, std::memory_order_relaxed);
+            startNodes_.clear();
+            exactStates_.clear();
+            goals_.clear();
+            csr_.clear();
+            for (unsigned i=0 ; i<workers_.size() ; ++i)
+                workers_[i].reset();
+        }
+
+        // Freezes the roadmap into a compressed sparse row adjacency
+        // with contiguous node ids and precomputed edge costs, which
+        // solution() then searches instead of following the edge
+        // lists.  This is meant for a build-then-query use, in which
+        // the roadmap is solved once, and then compacted for repeated
+        // solution() calls.  Adding a start or goal, solving, or
+        // resetting discards the compacted roadmap, and compact()
+        // must be called again to use it.  The edge lists are kept,
+        // thus the compacted roadmap is in addition to the memory of
+        // the roadmap.  Must not be called while solving, and not
+        // supported with a shared roadmap, which other processes may
+        // be changing.
+        void compact() {
+            static_assert(!shared, "a shared roadmap cannot be compacted");
+            csr_.build(
+                [&] (auto&& fn) {
+                    for (unsigned i=0 ; i<workers_.size() ; ++i)
+                        workers_[i].forEachNode(fn);
+                },
+                startNodes_);
+            MPT_LOG(DEBUG) << "compacted " << csr_.size() << " nodes, " << csr_.edgeCount() << " edges";
+        }
+
+        // true when the roadmap has been compacted, and has not
+        // changed since.
+        bool compacted() const {
+            return !csr_.empty();
         }
 
         // required to get convenience methods
-        using Base::solve;
+        using Base::solveFor;
+        using Base::solveUntil;
 
         // required method
         template <typename DoneFn>
         std::enable_if_t<std::is_same_v<bool, std::result_of_t<DoneFn()>>>
         solve(DoneFn doneFn) {
+            csr_.clear();
+            if constexpr (shared)
+                importShared();
+
             using Goal = scenario_goal_t<Scenario>;
             if constexpr (goal_has_sampler_v<Goal>)
-                if (goalNodes_.empty())
+                if (goals_.empty())
                     workers_[0].sampleGoals(*this);
 
-            if (goalNodes_.empty() || startNodes_.empty())
+            if (goals_.empty() || startNodes_.empty())
                 throw std::runtime_error("PPRM requires both start and goal configurations");
 
-            workers_.solve(*this, doneFn);
+            if constexpr (shared)
+                if (!solved() && startConnectedToGoal())
+                    solutionFound();
+
+            auto budgetDoneFn = budget_.doneFn(workers_.size(), std::move(doneFn));
+
+            if constexpr (deterministic)
+                workers_.solveRounds(*this, budgetDoneFn);
+            else
+                workers_.solve(*this, budgetDoneFn);
+        }
+
+        // the bytes charged to the memory budget (0 without a
+        // memory_budget)
+        std::size_t memoryUsed() const {
+            return budget_.used();
+        }
+
+        // true when the last solve() stopped because of the memory
+        // budget.
+        bool memoryBudgetReached() const {
+            return budget_.reached();
         }
 
         bool solved() const {
@@ -150,10 +494,23 @@ namespace unc::robotics::mpt::impl::pprm {
         }
 
         std::vector<State> solution() const {
+            if (compacted())
+                return compactSolution();
+
+            // with a shared roadmap, the goal flag on the node may
+            // have been set by another process.
+            std::unordered_set<
+                const Node*, std::hash<const Node*>, std::equal_to<const Node*>, Alloc<const Node*>> goals;
+            if constexpr (shared)
+                for (const GoalRecord *g = goals_.head() ; g ; g = g->next())
+                    goals.insert(g->node());
+
             using QItem = std::tuple<Distance, const Node*>;
             auto compare = [] (const QItem& a, const QItem& b) { return std::get<0>(a) > std::get<0>(b); };
-            std::unordered_map<const Node*, QItem> nodeInfo;
-            std::priority_queue<QItem, std::vector<QItem>, decltype(compare)> q(compare);
+            std::unordered_map<
+                const Node*, QItem, std::hash<const Node*>, std::equal_to<const Node*>,
+                Alloc<std::pair<const Node* const, QItem>>> nodeInfo;
+            std::priority_queue<QItem, Vector<QItem>, decltype(compare)> q(compare);
 
             for (const Node* n : startNodes_) {
                 nodeInfo[n] = std::tuple<Distance, const Node*>(0, nullptr);
@@ -171,23 +528,24 @@ namespace unc::robotics::mpt::impl::pprm {
 
                 assert(std::get<Distance>(nodeInfo[min]) == dMin);
 
-                if (goalNodes_.find(min) != goalNodes_.end()) {
+                if (shared ? goals.count(min) != 0 : min->goal()) {
                     MPT_LOG(DEBUG) << "goal expaned";
                     for (const Node *n = min ; n ; n = std::get<const Node*>(nodeInfo[n]))
-                        path.push_back(n->state());
+                        path.push_back(state(n));
                     std::reverse(path.begin(), path.end());
                     break;
                 }
 
-                for (const Edge *e = min->edges() ; e ; e = e->next()) {
-                    Distance d = dMin + workers_[0].space().distance(min->state(), e->to()->state());
-                    auto dBest = nodeInfo.find(e->to());
+                for (const Edge *e = min->edges() ; e ; e = e->next(min)) {
+                    const Node *to = e->to(min);
+                    Distance d = dMin + workers_[0].space().distance(state(min), state(to));
+                    auto dBest = nodeInfo.find(to);
                     if (dBest == nodeInfo.end()) {
-                        nodeInfo[e->to()] = {d, min};
-                        q.emplace(d, e->to());
+                        nodeInfo[to] = {d, min};
+                        q.emplace(d, to);
                     } else if (d < std::get<Distance>(dBest->second)) {
                         dBest->second = {d, min}; // std::make_tuple(d, min);
-                        q.emplace(d, e->to());
+                        q.emplace(d, to);
                     }
                 }
             }
@@ -195,116 +553,337 @@ namespace unc::robotics::mpt::impl::pprm {
             return path;
         }
 
+        // the memory used by the planner's pools and buffers, summed
+        // over the workers.
+        MemoryStats memoryStats() const {
+            MemoryStats stats;
+            stats.add("nn index (estimate)", nn_.size(), nn_.size() * kNNBytesPerEntry);
+            stats.add("compacted roadmap", csr_.size(), csr_.bytes());
+            for (unsigned i=0 ; i<workers_.size() ; ++i)
+                stats += workers_[i].memoryStats();
+            return stats;
+        }
+
+        // the workers' stats, summed.  Empty unless reportStats.
+        WorkerStats<reportStats> stats() const {
+            WorkerStats<reportStats> stats;
+            if constexpr (reportStats) {
+                for (unsigned i=0 ; i<workers_.size() ; ++i)
+                    stats += workers_[i];
+            }
+            return stats;
+        }
+
         void printStats() const {
             MPT_LOG(INFO) << "nodes in graph: " << nn_.size();
+            if constexpr (reportStats)
+                stats().print();
+            for (unsigned i=0 ; i<workers_.size() ; ++i)
+                workers_[i].memoryStats().print("worker " + std::to_string(i));
+            memoryStats().print("planner");
         }
     };
 
-    template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy>
-    class PPRM<Scenario, maxThreads, reportStats, NNStrategy>::Worker {
+    template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy, bool deterministic,
+              bool shared, int sampleBatch, bool quantized, typename PoolStrategy, typename Allocator,
+              std::size_t memoryBudget>
+    class PPRM<Scenario, maxThreads, reportStats, NNStrategy, deterministic, shared, sampleBatch,
+               quantized, PoolStrategy, Allocator, memoryBudget>::Worker
+        : public WorkerStats<reportStats>
+    {
+        using Stats = WorkerStats<reportStats>;
+
         unsigned no_;
         Scenario scenario_;
         RNG rng_;
 
-        ObjectPool<Node> nodePool_;
-        ObjectPool<Edge> edgePool_;
-        ObjectPool<Component> componentPool_;
-
-        std::vector<std::tuple<Distance, Node*>> nbh_;
+        Pool<Node> nodePool_;
+        Pool<Edge> edgePool_;
+        ObjectPool<GoalRecord, true, Alloc<GoalRecord>> goalPool_;
+        MemoryCharge<shared ? 0 : memoryBudget> charge_;
+
+        Vector<std::tuple<Distance, Node*>> nbh_;
+
+        // the sample prepared by prepareSample() and added to the
+        // graph by commitSample().  The neighbors to connect are
+        // left in nbh_.  When the motions to them were already
+        // checked (when solving deterministically or in a batch),
+        // pendingChecked_ is true and the neighbors with invalid
+        // motions are set to null.  With quantized states,
+        // pendingExact_ is true for a start or goal, which keeps its
+        // exact state.
+        std::optional<State> pendingState_;
+        std::conditional_t<quantized, Stored, std::nullptr_t> pendingEncoded_{};
+        ComponentFlags::Flags pendingFlags_{ComponentFlags::kNone};
+        bool pendingGoal_{false};
+        bool pendingChecked_{false};
+        bool pendingExact_{false};
+
+        // the current batch of samples when sampleBatch > 1, stored
+        // contiguously for validBatch().  The neighborhoods of the
+        // batch's valid samples are concatenated in batchNbh_, with
+        // sample i's ending at batchNbhEnd_[i].  The motions to the
+        // neighbors are stored contiguously in batchFrom_ and
+        // batchTo_ for linkBatch(), with the results in batchLinked_.
+        static constexpr bool batched = sampleBatch > 1 && !deterministic;
+        Vector<State> batchStates_;
+        Vector<Stored> batchEncoded_; // only used when quantized
+        std::unique_ptr<bool[]> batchValid_;
+        Vector<std::tuple<Distance, Node*>> batchNbh_;
+        Vector<std::size_t> batchNbhEnd_;
+        Vector<State> batchFrom_;
+        Vector<State> batchTo_;
+        std::unique_ptr<bool[]> batchLinked_;
+        std::size_t batchLinkedCapacity_{0};
 
     public:
         Worker(Worker&& other)
-            : no_(other.no_)
+            : Stats(std::move(other))
+            , no_(other.no_)
             , scenario_(std::move(other.scenario_))
             , rng_(std::move(other.rng_))
             , nodePool_(std::move(other.nodePool_))
+            , edgePool_(std::move(other.edgePool_))
+            , goalPool_(std::move(other.goalPool_))
+            , charge_(other.charge_)
+            , pendingState_(std::move(other.pendingState_))
+            , pendingEncoded_(std::move(other.pendingEncoded_))
+            , pendingFlags_(other.pendingFlags_)
+            , pendingGoal_(other.pendingGoal_)
+            , pendingChecked_(other.pendingChecked_)
+            , pendingExact_(other.pendingExact_)
+            , batchStates_(std::move(other.batchStates_))
+            , batchEncoded_(std::move(other.batchEncoded_))
+            , batchValid_(std::move(other.batchValid_))
+            , batchNbh_(std::move(other.batchNbh_))
+            , batchNbhEnd_(std::move(other.batchNbhEnd_))
+            , batchFrom_(std::move(other.batchFrom_))
+            , batchTo_(std::move(other.batchTo_))
+            , batchLinked_(std::move(other.batchLinked_))
+            , batchLinkedCapacity_(std::exchange(other.batchLinkedCapacity_, 0))
         {
         }
 
-        template <typename RNGSeed>
-        Worker(unsigned no, const Scenario& scenario, const RNGSeed& seed)
+        // poolArgs are passed to each roadmap Pool's constructor
+        template <typename RNGSeed, typename ... PoolArgs>
+        Worker(unsigned no, const Scenario& scenario, const RNGSeed& seed, const PoolArgs& ... poolArgs)
             : no_(no)
-            , scenario_(scenario)
-            , rng_(seed)
+            , scenario_(workerScenario(scenario))
+            , rng_(deterministic ? workerRNG<RNG>(seed, no) : RNG(seed))
+            , nodePool_(poolArgs...)
+            , edgePool_(poolArgs...)
         {
+            if constexpr (batched) {
+                batchStates_.reserve(sampleBatch);
+                if constexpr (quantized)
+                    batchEncoded_.reserve(sampleBatch);
+                batchValid_.reset(new bool[sampleBatch]);
+                batchNbhEnd_.reserve(sampleBatch);
+            }
         }
 
         const Space& space() const {
             return scenario_.space();
         }
 
+        // see PPRM::reset()
+        void reset() {
+            static_cast<Stats&>(*this) = Stats();
+            nodePool_.clear();
+            edgePool_.clear();
+            goalPool_.clear();
+            nbh_.clear();
+            pendingState_.reset();
+            batchStates_.clear();
+            batchEncoded_.clear();
+            batchNbh_.clear();
+            batchNbhEnd_.clear();
+            batchFrom_.clear();
+            batchTo_.clear();
+        }
+
         void sampleGoals(Planner& planner) {
             // TODO: more than one sample when appropriate
             using Goal = scenario_goal_t<Scenario>;
             GoalSampler<Goal> goalSampler(scenario_.goal());
-            addSample(planner, goalSampler(rng_), Component::kGoal);
+            addSample(planner, goalSampler(rng_), ComponentFlags::kGoal);
         }
 
-        void addSample(Planner& planner, std::optional<State>&& sample, Component::Flags flags) {
+        void addSample(Planner& planner, std::optional<State>&& sample, ComponentFlags::Flags flags) {
             if (sample)
                 addSample(planner, *sample, flags);
         }
 
-        Node* addSample(Planner& planner, const State& q, Component::Flags flags) {
-            if (!scenario_.valid(q))
-                return nullptr;
+        Node* addSample(Planner& planner, const State& q, ComponentFlags::Flags flags) {
+            pendingState_.reset();
+            prepareSample(planner, q, flags);
+            return commitSample(planner);
+        }
 
+        void prepareSample(Planner& planner, std::optional<State>&& sample, ComponentFlags::Flags flags) {
+            if (sample)
+                prepareSample(planner, *sample, flags);
+        }
+
+        void prepareSample(Planner& planner, const State& q, ComponentFlags::Flags flags) {
+            if constexpr (quantized) {
+                pendingEncoded_ = planner.codec_.encode(q);
+                if (flags != ComponentFlags::kNone) {
+                    // starts and goals keep their exact states (see
+                    // PPRM::ExactState).
+                    if (scenario_.valid(q))
+                        prepareValidSample(planner, q, flags);
+                } else {
+                    // the sample is replaced by its decoded state, so
+                    // that the checked state is the state stored.
+                    State s = planner.codec_.decode(pendingEncoded_);
+                    if (scenario_.valid(s))
+                        prepareValidSample(planner, s, flags);
+                }
+            } else if (scenario_.valid(q)) {
+                prepareValidSample(planner, q, flags);
+            }
+        }
+
+        // the remainder of prepareSample() once q is known to be
+        // valid.
+        void prepareValidSample(Planner& planner, const State& q, ComponentFlags::Flags flags) {
+            // starts and goals are added even when a node is already
+            // at their state, since the planner must track them.
+            if (!findNeighbors(planner, q) && flags == ComponentFlags::kNone)
+                return;
+
+            // when solving deterministically, the motions must be
+            // checked here, as commitSample() runs on one thread.
+            if constexpr (deterministic) {
+                for (auto& [d, nbr] : nbh_)
+                    if (!validMotion(q, planner.state(nbr)))
+                        nbr = nullptr;
+            }
+
+            setPending(q, flags, deterministic);
+        }
+
+        // finds the neighbors of q to connect to, leaving them in
+        // nbh_.  Returns false if q is (numerically) already in the
+        // roadmap.
+        bool findNeighbors(Planner& planner, const State& q) {
             Distance logSizePlus1 = std::log(planner.nn_.size() + 1);
             int k = std::ceil(planner.kRRG_ * logSizePlus1);
             planner.nn_.nearest(nbh_, q, k);
 
             Distance minDist = std::numeric_limits<Distance>::epsilon();
-            if (!nbh_.empty() && std::get<Distance>(nbh_[0]) < minDist)
-                return nullptr;
+            return nbh_.empty() || std::get<Distance>(nbh_[0]) >= minDist;
+        }
 
+        // makes q the sample for commitSample() to add, connecting
+        // it to the neighbors in nbh_.
+        void setPending(const State& q, ComponentFlags::Flags flags, bool checked) {
             bool isGoal;
+            pendingExact_ = quantized && flags != ComponentFlags::kNone;
 
-            if ((flags & Component::kGoal) != 0) {
+            if ((flags & ComponentFlags::kGoal) != 0) {
                 isGoal = true;
             } else if ((isGoal = scenario_.goal()(scenario_.space(), q).first) == true) {
-                flags = static_cast<Component::Flags>(flags | Component::kGoal);
+                flags = static_cast<ComponentFlags::Flags>(flags | ComponentFlags::kGoal);
             }
 
-            Component *component = componentPool_.allocate(1, flags);
-            Node *n = nodePool_.allocate(component, q);
+            pendingState_ = q;
+            pendingFlags_ = flags;
+            pendingGoal_ = isGoal;
+            pendingChecked_ = checked;
+        }
+
+        Node* commitSample(Planner& planner) {
+            if (!pendingState_)
+                return nullptr;
 
-            if (isGoal)
-                planner.foundGoal(n);
+            const State& q = *pendingState_;
+            Node *n;
+            if constexpr (quantized)
+                n = nodePool_.allocate(pendingFlags_, pendingGoal_, pendingEncoded_);
+            else
+                n = nodePool_.allocate(pendingFlags_, pendingGoal_, q);
+
+            if (pendingExact_)
+                planner.addExactState(n, q);
+
+            if (pendingGoal_)
+                planner.foundGoal(goalPool_.allocate(n, Distance(0)));
 
             for (auto [d, nbr] : nbh_) {
-                if (!validMotion(q, nbr->state()))
+                if (pendingChecked_ ? nbr == nullptr : !validMotion(q, planner.state(nbr)))
                     continue;
 
-                Component *c0 = nbr->addEdge(edgePool_.allocate(n, d));
-                Component *c1 = n->addEdge(edgePool_.allocate(nbr, d));
-                Component *cm = merge(c0, c1);
-
-                if (cm->isSolution())
+                // one edge record is linked into both nodes' lists.
+                Edge *edge = edgePool_.allocate(n, nbr, d);
+                Component *c0 = nbr->addEdge(edge, Stats::addEdgeCAS());
+                Component *c1 = n->addEdge(edge, Stats::addEdgeCAS());
+
+                if constexpr (shared) {
+                    // only a merge of one of this planner's starts
+                    // with a component with a goal can solve it.
+                    // Merges by other processes are checked at the
+                    // next solve().
+                    bool check = !planner.solved() && c0 != c1 && (
+                        (c1->isGoal() && planner.isStartComponent(c0)) ||
+                        (c0->isGoal() && planner.isStartComponent(c1)));
+                    Component::merge(c0, c1, Stats::mergeCAS());
+                    if (check && planner.startConnectedToGoal())
+                        planner.solutionFound();
+                } else if (Component::merge(c0, c1, Stats::mergeCAS())->isSolution()) {
                     planner.solutionFound();
+                }
             }
 
             planner.nn_.insert(n);
+            if constexpr (shared)
+                planner.segment_->record(kNodeRoot, n, planner.owner_);
+            pendingState_.reset();
+
+            if constexpr (memoryBudget != 0 && !shared)
+                charge_.update(planner.budget_, memoryUsed());
+
             return n;
         }
 
-        Component *merge(Component *a, Component *b) {
-            Component *t;
-            do {
-                while ((t = a->next()) != nullptr) a = t;
-                while ((t = b->next()) != nullptr) b = t;
-                if (a == b) return a;
-                if (a->size() > b->size())
-                    std::swap(a, b);
-                assert(t == nullptr);
-            } while (!a->casNext(t, b, std::memory_order_relaxed));
-
-            Component *m = componentPool_.allocate(a, b);
-            while (!b->casNext(t, m, std::memory_order_relaxed)) {
-                while ((t = b->next()) != nullptr) b = t;
-                m->update(a, b);
-            }
+        // the bytes used by this worker's pools and its share of the
+        // nearest neighbor structure.
+        std::size_t memoryUsed() const {
+            return nodePool_.bytes() + edgePool_.bytes() + goalPool_.bytes() + nodePool_.size() * kNNBytesPerEntry;
+        }
+
+        // with a shared roadmap, only the objects this worker
+        // allocated in the segment are counted.
+        MemoryStats memoryStats() const {
+            MemoryStats stats;
+            stats.addPool("nodes", nodePool_);
+            stats.addPool("edges", edgePool_);
+            stats.addPool("goals", goalPool_);
+            stats.addVector("neighborhood", nbh_);
+            stats.addVector("sample batch", batchStates_);
+            stats.addVector("sample batch", batchEncoded_);
+            stats.addVector("sample batch", batchNbh_);
+            stats.addVector("sample batch", batchNbhEnd_);
+            stats.addVector("sample batch", batchFrom_);
+            stats.addVector("sample batch", batchTo_);
+            stats.add("sample batch", 0, batchLinkedCapacity_ * sizeof(bool));
+            return stats;
+        }
+
+        // calls fn on each node this worker added to the roadmap, in
+        // the order added.
+        template <typename Fn>
+        void forEachNode(Fn&& fn) const {
+            for (std::size_t i=0 ; i<nodePool_.size() ; ++i)
+                fn(&nodePool_[i]);
+        }
 
-            return m;
+        // adds a node created by another process to the planner.
+        void importNode(Planner& planner, Node *n) {
+            planner.nn_.insert(n);
+            if (scenario_.goal()(scenario_.space(), planner.state(n)).first)
+                planner.foundGoal(goalPool_.allocate(n, Distance(0)));
         }
 
         bool validMotion(const State& a, const State& b) {
@@ -316,12 +895,103 @@ namespace unc::robotics::mpt::impl::pprm {
             MPT_LOG(TRACE) << "worker running";
 
             Sampler sampler(scenario_);
-            while (!done()) {
-                addSample(planner, sampler(rng_), Component::kNone);
+            if constexpr (batched) {
+                while (!done())
+                    addBatch(planner, sampler);
+            } else {
+                while (!done()) {
+                    Stats::countIteration();
+                    addSample(planner, sampler(rng_), ComponentFlags::kNone);
+                }
             }
 
             MPT_LOG(TRACE) << "worker done";
         }
+
+        // draws a batch of samples, checks them together, then adds
+        // the valid ones to the roadmap.
+        void addBatch(Planner& planner, Sampler& sampler) {
+            batchStates_.clear();
+            batchEncoded_.clear();
+            for (int i=0 ; i<sampleBatch ; ++i) {
+                Stats::countIteration();
+                if (std::optional<State> q = sampler(rng_)) {
+                    if constexpr (quantized) {
+                        batchEncoded_.push_back(planner.codec_.encode(*q));
+                        batchStates_.push_back(planner.codec_.decode(batchEncoded_.back()));
+                    } else {
+                        batchStates_.push_back(std::move(*q));
+                    }
+                }
+            }
+
+            std::size_t n = batchStates_.size();
+            validBatch(scenario_, batchStates_.data(), n, batchValid_.get());
+
+            // find the neighborhoods of the valid samples back to
+            // back, keeping the samples that are not already in the
+            // roadmap.  Since the samples are added after all the
+            // queries, samples in the same batch do not connect to
+            // each other.
+            std::size_t m = 0;
+            batchNbh_.clear();
+            batchNbhEnd_.clear();
+            for (std::size_t i=0 ; i<n ; ++i) {
+                if (!batchValid_[i] || !findNeighbors(planner, batchStates_[i]))
+                    continue;
+                if (m != i) {
+                    batchStates_[m] = std::move(batchStates_[i]);
+                    if constexpr (quantized)
+                        batchEncoded_[m] = batchEncoded_[i];
+                }
+                batchNbh_.insert(batchNbh_.end(), nbh_.begin(), nbh_.end());
+                batchNbhEnd_.push_back(batchNbh_.size());
+                ++m;
+            }
+
+            // check the motions to the neighbors together
+            std::size_t nMotions = batchNbh_.size();
+            batchFrom_.clear();
+            batchTo_.clear();
+            for (std::size_t i=0, j=0 ; i<m ; ++i) {
+                for ( ; j<batchNbhEnd_[i] ; ++j) {
+                    batchFrom_.push_back(batchStates_[i]);
+                    batchTo_.push_back(planner.state(std::get<Node*>(batchNbh_[j])));
+                }
+            }
+            if (batchLinkedCapacity_ < nMotions) {
+                batchLinked_.reset(new bool[nMotions]);
+                batchLinkedCapacity_ = nMotions;
+            }
+            validMotionBatch(scenario_, batchFrom_.data(), batchTo_.data(), nMotions, batchLinked_.get());
+
+            // then add the samples, connecting the valid motions
+            for (std::size_t i=0, j=0 ; i<m ; ++i) {
+                nbh_.clear();
+                for ( ; j<batchNbhEnd_[i] ; ++j) {
+                    auto [d, nbr] = batchNbh_[j];
+                    nbh_.emplace_back(d, batchLinked_[j] ? nbr : nullptr);
+                }
+                if constexpr (quantized)
+                    pendingEncoded_ = batchEncoded_[i];
+                setPending(batchStates_[i], ComponentFlags::kNone, true);
+                commitSample(planner);
+            }
+        }
+
+        // prepares one sample for a round of deterministic solving,
+        // without modifying the graph, so that all workers can
+        // prepare concurrently.
+        void prepare(Planner& planner) {
+            Stats::countIteration();
+            pendingState_.reset();
+            Sampler sampler(scenario_);
+            prepareSample(planner, sampler(rng_), ComponentFlags::kNone);
+        }
+
+        void commit(Planner& planner) {
+            commitSample(planner);
+        }
     };
 }
 
@@ -37,13 +37,16 @@
 #ifndef MPT_IMPL_PRRT_NODE_HPP
 #define MPT_IMPL_PRRT_NODE_HPP
 
+#include "../compact_ptr.hpp"
 #include <utility>
 
 namespace unc::robotics::mpt::impl::prrt {
-    template <typename State>
+    // When compact is true, the parent is stored as a 32-bit
+    // CompactPtr, thus nodes must be allocated from a CompactPool.
+    template <typename State, bool compact = false>
     class Node {
         State state_;
-        Node *parent_;
+        cptr_t<Node, compact> parent_;
 
     public:
         template <typename ... Args>
@@ -63,8 +66,8 @@ namespace unc::robotics::mpt::impl::prrt {
     };
 
     struct NodeKey {
-        template <typename State>
-        const State& operator() (const Node<State>* node) const {
+        template <typename State, bool compact>
+        const State& operator() (const Node<State, compact>* node) const {
             return node->state();
         }
     };
@@ -0,0 +1,482 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_PRRT_PIPELINE_HPP
+#define MPT_IMPL_PRRT_PIPELINE_HPP
+
+#include "prrt.hpp"
+#include "../bounded_queue.hpp"
+#include <exception>
+#include <thread>
+
+namespace unc::robotics::mpt::impl::prrt {
+
+    // PRRTPipeline is a variant of PRRT in which the steps of adding
+    // a sample to the tree run as separate pipeline stages, each with
+    // its own group of threads:
+    //
+    //   sample -> nearest -> validate -> insert
+    //
+    // The stages are connected by bounded lock-free queues.  This
+    // allows the number of threads to be matched to where the time
+    // goes (as reported by WorkerStats), e.g., more threads in the
+    // validate stage for scenarios with expensive collision checks,
+    // or a single insert thread to avoid contention on the nearest
+    // neighbor structure.
+    //
+    // Since the nearest stage may run ahead of the insert stage, a
+    // sample may be connected to a node that is not the nearest once
+    // all pending inserts have completed.  This is the same
+    // relaxation that occurs with concurrent workers in PRRT.
+    template <typename Scenario,
+              int sampleThreads, int nearestThreads, int validateThreads, int insertThreads,
+              bool reportStats, typename NNStrategy>
+    class PRRTPipeline : public PlannerBase<PRRTPipeline<
+        Scenario, sampleThreads, nearestThreads, validateThreads, insertThreads,
+        reportStats, NNStrategy>>
+    {
+        using Planner = PRRTPipeline;
+        using Base = PlannerBase<Planner>;
+        using Space = scenario_space_t<Scenario>;
+        using State = typename Space::Type;
+        using Distance = typename Space::Distance;
+        using Node = prrt::Node<State>;
+        using RNG = scenario_rng_t<Scenario, Distance>;
+        using Sampler = scenario_sampler_t<Scenario, RNG>;
+
+        static constexpr int kNearestBegin = sampleThreads;
+        static constexpr int kValidateBegin = kNearestBegin + nearestThreads;
+        static constexpr int kInsertBegin = kValidateBegin + validateThreads;
+        static constexpr int kThreads = kInsertBegin + insertThreads;
+
+        // the capacity of each queue between stages.  Must be a
+        // power of 2.
+        static constexpr std::size_t kQueueCapacity = 256;
+
+        // A candidate is a state and the node to which it will be
+        // connected.  Candidates flow from the nearest stage to the
+        // validate stage, and then from the validate stage to the
+        // insert stage.
+        struct Candidate {
+            Node *parent_{nullptr};
+            State state_;
+            bool goal_{false};
+        };
+
+        Distance maxDistance_{std::numeric_limits<Distance>::infinity()};
+        Distance goalBias_{0.01};
+
+        nigh::Nigh<Node*, Space, NodeKey, nigh::Concurrent, NNStrategy> nn_;
+
+        std::mutex mutex_;
+
+        using Goals = GoalList<const Node, Distance, true>;
+        using GoalRecord = typename Goals::Goal;
+        Goals goals_;
+
+        ObjectPool<Node, false> startNodes_;
+
+        BoundedQueue<State> samples_{kQueueCapacity};
+        BoundedQueue<Candidate> candidates_{kQueueCapacity};
+        BoundedQueue<Candidate> validated_{kQueueCapacity};
+
+        struct Worker;
+
+        std::vector<Worker> workers_;
+
+        void foundGoal(GoalRecord* goal) {
+            if (goals_.push(goal))
+                MPT_LOG(INFO) << "found solution with cost " << goal->cost();
+        }
+
+    public:
+        template <typename RNGSeed = RandomDeviceSeed<>>
+        explicit PRRTPipeline(const Scenario& scenario = Scenario(), const RNGSeed& seed = RNGSeed())
+            : nn_(scenario.space())
+        {
+            MPT_LOG(TRACE) << "Using nearest: " << log::type_name<NNStrategy>();
+            MPT_LOG(TRACE) << "Using sampler: " << log::type_name<Sampler>();
+
+            workers_.reserve(kThreads);
+            for (unsigned no=0 ; no<kThreads ; ++no)
+                workers_.emplace_back(no, scenario, seed);
+        }
+
+        void setGoalBias(Distance bias) {
+            assert(0 <= bias && bias <= 1);
+            goalBias_ = bias;
+        }
+
+        Distance getGoalBias() const {
+            return goalBias_;
+        }
+
+        void setRange(Distance range) {
+            assert(range > 0);
+            maxDistance_ = range;
+        }
+
+        Distance getRange() const {
+            return maxDistance_;
+        }
+
+        std::size_t size() const {
+            return nn_.size();
+        }
+
+        template <typename ... Args>
+        void addStart(Args&& ... args) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Node *node = startNodes_.allocate(nullptr, std::forward<Args>(args)...);
+            nn_.insert(node);
+        }
+
+        // Removes all nodes, including the start states, so that the
+        // planner can be reused for another query, keeping the
+        // workers' scenario copies, random number generators, and
+        // pool storage.  Worker stats are cleared.  Must not be
+        // called while solving.
+        void reset() {
+            // samples and candidates left in the queues when the last
+            // solve() stopped refer to the nodes being removed.
+            State sample;
+            Candidate candidate;
+            while (samples_.tryPop(sample)) {}
+            while (candidates_.tryPop(candidate) || validated_.tryPop(candidate)) {}
+
+            nn_.clear();
+            goals_.clear();
+            startNodes_.clear();
+            for (Worker& worker : workers_) {
+                worker.nodePool_.clear();
+                worker.goalPool_.clear();
+                static_cast<WorkerStats<reportStats>&>(worker) = WorkerStats<reportStats>();
+                worker.stalls_ = 0;
+            }
+        }
+
+        // required to get convenience methods
+        using Base::solveFor;
+        using Base::solveUntil;
+
+        // required method
+        template <typename DoneFn>
+        std::enable_if_t<std::is_same_v<bool, std::result_of_t<DoneFn()>>>
+        solve(DoneFn doneFn) {
+            if (size() == 0)
+                throw std::runtime_error("there are no valid initial states");
+
+            MPT_LOG(INFO) << "solving with pipeline of "
+                          << sampleThreads << " sample, "
+                          << nearestThreads << " nearest, "
+                          << validateThreads << " validate, and "
+                          << insertThreads << " insert threads";
+
+            // every stage must have at least one thread running, or
+            // the pipeline stalls.  Thus unlike WorkerPool, we cannot
+            // fall back to fewer threads than requested.  Exceptions
+            // cannot propagate out of the parallel region, so the
+            // first one stops the pipeline, and is rethrown after all
+            // stages have returned.
+            std::atomic_bool done{false};
+            std::atomic_bool underSubscribed{false};
+            std::exception_ptr error;
+#pragma omp parallel num_threads(kThreads) shared(done, underSubscribed, error)
+            {
+                if (omp_get_num_threads() != kThreads) {
+                    underSubscribed.store(true, std::memory_order_relaxed);
+                } else {
+                    int tNo = omp_get_thread_num();
+                    try {
+                        if (tNo == 0) {
+                            // also stop if another stage failed
+                            workers_[0].solve(*this, [&] {
+                                return done.load(std::memory_order_relaxed) || doneFn(); });
+                            done.store(true, std::memory_order_relaxed);
+                        } else {
+                            workers_[tNo].solve(*this, [&] { return done.load(std::memory_order_relaxed); });
+                        }
+                    } catch (...) {
+                        done.store(true, std::memory_order_relaxed);
+#pragma omp critical
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+            }
+
+            if (error)
+                std::rethrow_exception(error);
+            if (underSubscribed.load())
+                throw std::runtime_error("pipeline could not start all of its threads");
+        }
+
+        bool solved() const {
+            return !goals_.empty();
+        }
+
+        std::vector<State> solution() const {
+            std::vector<State> path;
+            if (const GoalRecord *goal = goals_.best()) {
+                for (const Node *n = goal->node() ; n ; n = n->parent())
+                    path.push_back(n->state());
+                std::reverse(path.begin(), path.end());
+            }
+            return path;
+        }
+
+        void printStats() const {
+            MPT_LOG(INFO) << "nodes in graph: " << nn_.size();
+            MemoryStats memory;
+            memory.add("nn index (estimate)", nn_.size(), nn_.size() * kNNBytesPerEntry);
+            memory.addPool("start nodes", startNodes_);
+            for (const Worker& worker : workers_) {
+                memory.addPool("nodes", worker.nodePool_);
+                memory.addPool("goals", worker.goalPool_);
+            }
+            memory.print("planner");
+            if constexpr (reportStats) {
+                WorkerStats<true> stats;
+                for (const Worker& worker : workers_)
+                    stats += worker;
+                stats.print();
+
+                std::size_t stalls[4] = {};
+                for (const Worker& worker : workers_)
+                    stalls[worker.stage()] += worker.stalls_;
+                MPT_LOG(INFO) << "queue stalls: "
+                              << stalls[0] << " sample, "
+                              << stalls[1] << " nearest, "
+                              << stalls[2] << " validate, "
+                              << stalls[3] << " insert";
+            }
+        }
+    };
+
+    template <typename Scenario,
+              int sampleThreads, int nearestThreads, int validateThreads, int insertThreads,
+              bool reportStats, typename NNStrategy>
+    struct PRRTPipeline<Scenario, sampleThreads, nearestThreads, validateThreads, insertThreads,
+                        reportStats, NNStrategy>::Worker
+        : public WorkerStats<reportStats>
+    {
+        using Stats = WorkerStats<reportStats>;
+
+        unsigned no_;
+        Scenario scenario_;
+        RNG rng_;
+
+        ObjectPool<Node> nodePool_;
+        ObjectPool<GoalRecord> goalPool_;
+
+        // the number of times this worker found its input queue
+        // empty or its output queue full.
+        std::size_t stalls_{0};
+
+        Worker(Worker&& other)
+            : Stats(std::move(other))
+            , no_(other.no_)
+            , scenario_(other.scenario_)
+            , rng_(other.rng_)
+            , nodePool_(std::move(other.nodePool_))
+            , goalPool_(std::move(other.goalPool_))
+            , stalls_(other.stalls_)
+        {
+        }
+
+        template <typename RNGSeed>
+        Worker(unsigned no, const Scenario& scenario, const RNGSeed& seed)
+            : no_(no)
+            , scenario_(workerScenario(scenario))
+            , rng_(seed)
+        {
+        }
+
+        // 0 = sample, 1 = nearest, 2 = validate, 3 = insert
+        int stage() const {
+            return (int(no_) >= kNearestBegin) + (int(no_) >= kValidateBegin) + (int(no_) >= kInsertBegin);
+        }
+
+        template <typename T, typename DoneFn>
+        bool push(BoundedQueue<T>& queue, T&& value, DoneFn& done) {
+            while (!queue.tryPush(std::move(value))) {
+                ++stalls_;
+                if (done())
+                    return false;
+                std::this_thread::yield();
+            }
+            return true;
+        }
+
+        template <typename T>
+        bool pop(BoundedQueue<T>& queue, T& value) {
+            if (queue.tryPop(value))
+                return true;
+            ++stalls_;
+            std::this_thread::yield();
+            return false;
+        }
+
+        template <typename DoneFn>
+        void solve(Planner& planner, DoneFn done) {
+            MPT_LOG(TRACE) << "worker " << no_ << " running stage " << stage();
+            switch (stage()) {
+            case 0: sample(planner, done); break;
+            case 1: nearest(planner, done); break;
+            case 2: validate(planner, done); break;
+            default: insert(planner, done); break;
+            }
+            MPT_LOG(TRACE) << "worker " << no_ << " done";
+        }
+
+        template <typename DoneFn>
+        bool sampled(Planner& planner, std::optional<State>&& sample, DoneFn& done) {
+            return !sample || push(planner.samples_, std::move(*sample), done);
+        }
+
+        template <typename DoneFn>
+        bool sampled(Planner& planner, State&& sample, DoneFn& done) {
+            return push(planner.samples_, std::move(sample), done);
+        }
+
+        template <typename DoneFn>
+        void sample(Planner& planner, DoneFn& done) {
+            Sampler sampler(scenario_);
+            using Goal = scenario_goal_t<Scenario>;
+            if constexpr (goal_has_sampler_v<Goal>) {
+                if (no_ == 0 && planner.goalBias_ > 0) {
+                    GoalSampler<Goal> goalSampler(scenario_.goal());
+                    std::uniform_real_distribution<Distance> uniform01;
+                    Distance scaledBias = planner.goalBias_ * sampleThreads;
+
+                    while (!done() && !planner.solved()) {
+                        Stats::countIteration();
+                        if (uniform01(rng_) < scaledBias) {
+                            Stats::countBiasedSample();
+                            if (!sampled(planner, goalSampler(rng_), done))
+                                return;
+                        } else if (!sampled(planner, sampler(rng_), done)) {
+                            return;
+                        }
+                    }
+                }
+            }
+
+            while (!done()) {
+                Stats::countIteration();
+                if (!sampled(planner, sampler(rng_), done))
+                    return;
+            }
+        }
+
+        template <typename DoneFn>
+        void nearest(Planner& planner, DoneFn& done) {
+            State randState;
+            while (!done()) {
+                if (!pop(planner.samples_, randState))
+                    continue;
+
+                Candidate candidate;
+                Distance d;
+                {
+                    Timer timer(Stats::nearest());
+                    std::tie(candidate.parent_, d) = planner.nn_.nearest(randState).value();
+                }
+
+                // see PRRT::Worker::addSample
+                if (d == 0)
+                    continue;
+
+                candidate.state_ = (d > planner.maxDistance_)
+                    ? interpolate(
+                        scenario_.space(),
+                        candidate.parent_->state(), randState,
+                        planner.maxDistance_ / d)
+                    : randState;
+
+                if (!push(planner.candidates_, std::move(candidate), done))
+                    return;
+            }
+        }
+
+        template <typename DoneFn>
+        void validate(Planner& planner, DoneFn& done) {
+            Candidate candidate;
+            while (!done()) {
+                if (!pop(planner.candidates_, candidate))
+                    continue;
+
+                if (!scenario_.valid(candidate.state_))
+                    continue;
+
+                {
+                    Timer timer(Stats::validMotion());
+                    if (!scenario_.link(candidate.parent_->state(), candidate.state_))
+                        continue;
+                }
+
+                candidate.goal_ = scenario_.goal()(scenario_.space(), candidate.state_).first;
+
+                if (!push(planner.validated_, std::move(candidate), done))
+                    return;
+            }
+        }
+
+        template <typename DoneFn>
+        void insert(Planner& planner, DoneFn& done) {
+            Candidate candidate;
+            while (!done()) {
+                if (!pop(planner.validated_, candidate))
+                    continue;
+
+                Node *newNode = nodePool_.allocate(candidate.parent_, candidate.state_);
+                planner.nn_.insert(newNode);
+
+                if (candidate.goal_)
+                    planner.foundGoal(goalPool_.allocate(newNode, pathCost(newNode)));
+            }
+        }
+
+        Distance pathCost(const Node *n) const {
+            Distance cost = 0;
+            for (const Node *p ; (p = n->parent()) != nullptr ; n = p)
+                cost += scenario_.space().distance(n->state(), p->state());
+            return cost;
+        }
+    };
+}
+
+#endif
@@ -39,19 +39,33 @@
 
 #include "node.hpp"
 #include "../atom.hpp"
+#include "../finally.hpp"
 #include "../goal_has_sampler.hpp"
+#include "../goal_list.hpp"
+#include "../memory_budget.hpp"
+#include "../memory_stats.hpp"
+#include "../nn_insert.hpp"
 #include "../object_pool.hpp"
 #include "../planner_base.hpp"
+#include "../pool_strategy.hpp"
 #include "../scenario_goal.hpp"
+#include "../scenario_async.hpp"
 #include "../scenario_rng.hpp"
 #include "../scenario_sampler.hpp"
+#include "../scenario_shared.hpp"
 #include "../scenario_space.hpp"
+#include "../scenario_valid_batch.hpp"
 #include "../timer_stat.hpp"
 #include "../worker_pool.hpp"
+#include "../worker_seed.hpp"
+#include "../../fixed_seed.hpp"
 #include "../../log.hpp"
 #include "../../random_device_seed.hpp"
-#include <forward_list>
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <vector>
 
 namespace unc::robotics::mpt::impl::prrt {
 
@@ -64,6 +78,7 @@ namespace unc::robotics::mpt::impl::prrt {
         void countBiasedSample() const {}
         auto& validMotion() { return TimerStat<void>::instance(); }
         auto& nearest() { return TimerStat<void>::instance(); }
+        auto& asyncWait() { return TimerStat<void>::instance(); }
     };
 
     template <>
@@ -72,18 +87,21 @@ namespace unc::robotics::mpt::impl::prrt {
         mutable std::size_t biasedSamples_{0};
         mutable TimerStat<> validMotion_;
         mutable TimerStat<> nearest_;
+        mutable TimerStat<> asyncWait_;
 
         void countIteration() const { ++iterations_; }
         void countBiasedSample() const { ++biasedSamples_; }
 
         TimerStat<>& validMotion() const { return validMotion_; }
         TimerStat<>& nearest() const { return nearest_; }
+        TimerStat<>& asyncWait() const { return asyncWait_; }
 
         WorkerStats& operator += (const WorkerStats& other) {
             iterations_ += other.iterations_;
             biasedSamples_ += other.biasedSamples_;
             validMotion_ += other.validMotion_;
             nearest_ += other.nearest_;
+            asyncWait_ += other.asyncWait_;
             return *this;
         }
 
@@ -92,53 +110,64 @@ namespace unc::robotics::mpt::impl::prrt {
             MPT_LOG(INFO) << "biased samples: " << biasedSamples_;
             MPT_LOG(INFO) << "valid motion: " << validMotion_;
             MPT_LOG(INFO) << "nearest: " << nearest_;
+            MPT_LOG(INFO) << "async wait: " << asyncWait_;
         }
     };
 
-    template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy>
-    class PRRT : public PlannerBase<PRRT<Scenario, maxThreads, reportStats, NNStrategy>> {
+    template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy, int insertBatch,
+              bool deterministic, int asyncDepth, int sampleBatch, typename PoolStrategy, typename Allocator,
+              std::size_t memoryBudget>
+    class PRRT : public PlannerBase<PRRT<
+        Scenario, maxThreads, reportStats, NNStrategy, insertBatch, deterministic, asyncDepth, sampleBatch,
+        PoolStrategy, Allocator, memoryBudget>>
+    {
         using Planner = PRRT;
         using Base = PlannerBase<Planner>;
         using Space = scenario_space_t<Scenario>;
         using State = typename Space::Type;
         using Distance = typename Space::Distance;
-        using Node = prrt::Node<State>;
+        using Node = prrt::Node<State, is_compact_v<PoolStrategy>>;
         using RNG = scenario_rng_t<Scenario, Distance>;
         using Sampler = scenario_sampler_t<Scenario, RNG>;
 
+        // the configured allocator, rebound to each type allocated
+        template <typename T>
+        using Alloc = rebind_alloc_t<Allocator, T>;
+        template <typename T>
+        using Vector = std::vector<T, Alloc<T>>;
+
         Distance maxDistance_{std::numeric_limits<Distance>::infinity()};
         Distance goalBias_{0.01};
 
         static constexpr bool concurrent = maxThreads != 1;
         using NNConcurrency = std::conditional_t<concurrent, nigh::Concurrent, nigh::NoThreadSafety>;
-        nigh::Nigh<Node*, Space, NodeKey, NNConcurrency, NNStrategy> nn_;
+        nigh::Nigh<Node*, Space, NodeKey, NNConcurrency, NNStrategy, Alloc<Node*>> nn_;
 
         std::mutex mutex_;
-        std::forward_list<Node*> goals_;
 
-        // we could use goals_.size(), but the performance of check if
-        // there is a solution can be critical, and goals_.size()
-        // requires a mutex lock.  Thus we store the goal count in an
-        // atomic for fast access.
-        Atom<std::size_t, concurrent> goalCount_{0};
+        // goals are pushed onto a lock-free list that also tracks
+        // the lowest cost goal.  Thus checking for a solution and
+        // returning the best one do not require a lock or a scan of
+        // all goals found.
+        using Goals = GoalList<const Node, Distance, concurrent>;
+        using GoalRecord = typename Goals::Goal;
+        Goals goals_;
 
-        ObjectPool<Node, false> startNodes_;
+        start_pool_t<Node, PoolStrategy, Allocator> startNodes_;
 
         struct Worker;
 
-        WorkerPool<Worker, maxThreads> workers_;
+        WorkerPool<Worker, maxThreads, Alloc<Worker>> workers_;
 
-        void foundGoal(Node* node) {
-            MPT_LOG(INFO) << "found solution";
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                goals_.push_front(node);
-            }
-            ++goalCount_;
+        MemoryBudget<memoryBudget> budget_;
+
+        void foundGoal(GoalRecord* goal) {
+            if (goals_.push(goal))
+                MPT_LOG(INFO) << "found solution with cost " << goal->cost();
         }
 
     public:
-        template <typename RNGSeed = RandomDeviceSeed<>>
+        template <typename RNGSeed = std::conditional_t<deterministic, FixedSeed, RandomDeviceSeed<>>>
         explicit PRRT(const Scenario& scenario = Scenario(), const RNGSeed& seed = RNGSeed())
             : nn_(scenario.space())
             , workers_(scenario, seed)
@@ -178,6 +207,20 @@ namespace unc::robotics::mpt::impl::prrt {
             nn_.insert(node);
         }
 
+        // Removes all nodes, including the start states, so that the
+        // planner can be reused for another query.  Unlike
+        // constructing a new planner, the workers keep their scenario
+        // copies, random number generators, and the storage of their
+        // pools and buffers.  Worker stats are cleared.  Must not be
+        // called while solving.
+        void reset() {
+            nn_.clear();
+            goals_.clear();
+            startNodes_.clear();
+            for (unsigned i=0 ; i<workers_.size() ; ++i)
+                workers_[i].reset();
+        }
+
         // required to get convenience methods
         using Base::solveFor;
         using Base::solveUntil;
@@ -189,54 +232,79 @@ namespace unc::robotics::mpt::impl::prrt {
             if (size() == 0)
                 throw std::runtime_error("there are no valid initial states");
 
-            workers_.solve(*this, doneFn);
+            auto budgetDoneFn = budget_.doneFn(workers_.size(), std::move(doneFn));
+
+            if constexpr (deterministic) {
+                workers_.solveRounds(*this, budgetDoneFn);
+                for (unsigned i=0 ; i<workers_.size() ; ++i)
+                    workers_[i].publish(*this);
+            } else {
+                workers_.solve(*this, budgetDoneFn);
+            }
         }
 
-        bool solved() const {
-            return goalCount_.load(std::memory_order_relaxed);
+        // the bytes charged to the memory budget (0 without a
+        // memory_budget)
+        std::size_t memoryUsed() const {
+            return budget_.used();
         }
 
-    private:
-        Distance buildSolution(std::vector<State>& path, const Node *n) const {
-            Distance cost = 0;
-            for (const Node *p ;; n = p) {
-                path.push_back(n->state());
-                if ((p = n->parent()) == nullptr)
-                    return cost;
-                cost += workers_[0].space().distance(n->state(), p->state());
-            }
+        // true when the last solve() stopped because of the memory
+        // budget.
+        bool memoryBudgetReached() const {
+            return budget_.reached();
+        }
+
+        bool solved() const {
+            return !goals_.empty();
         }
 
-    public:
         std::vector<State> solution() const {
-            std::vector<State> best;
-            std::vector<State> curr;
-            Distance shortest = std::numeric_limits<Distance>::infinity();
-            for (const Node *n : goals_) {
-                curr.clear();
-                Distance cost = buildSolution(curr, n);
-                if (cost < shortest) {
-                    std::swap(curr, best);
-                    shortest = cost;
-                }
+            std::vector<State> path;
+            if (const GoalRecord *goal = goals_.best()) {
+                for (const Node *n = goal->node() ; n ; n = n->parent())
+                    path.push_back(n->state());
+                std::reverse(path.begin(), path.end());
             }
-            std::reverse(best.begin(), best.end());
-            return best;
+            return path;
         }
 
-        void printStats() const {
-            MPT_LOG(INFO) << "nodes in graph: " << nn_.size();
+        // the memory used by the planner's pools and buffers, summed
+        // over the workers.
+        MemoryStats memoryStats() const {
+            MemoryStats stats;
+            stats.add("nn index (estimate)", nn_.size(), nn_.size() * kNNBytesPerEntry);
+            stats.addPool("start nodes", startNodes_);
+            for (unsigned i=0 ; i<workers_.size() ; ++i)
+                stats += workers_[i].memoryStats();
+            return stats;
+        }
+
+        // the workers' stats, summed.  Empty unless reportStats.
+        WorkerStats<reportStats> stats() const {
+            WorkerStats<reportStats> stats;
             if constexpr (reportStats) {
-                WorkerStats<true> stats;
                 for (unsigned i=0 ; i<workers_.size() ; ++i)
                     stats += workers_[i];
-                stats.print();
             }
+            return stats;
+        }
+
+        void printStats() const {
+            MPT_LOG(INFO) << "nodes in graph: " << nn_.size();
+            if constexpr (reportStats)
+                stats().print();
+            for (unsigned i=0 ; i<workers_.size() ; ++i)
+                workers_[i].memoryStats().print("worker " + std::to_string(i));
+            memoryStats().print("planner");
         }
     };
 
-    template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy>
-    class PRRT<Scenario, maxThreads, reportStats, NNStrategy>::Worker
+    template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy, int insertBatch,
+              bool deterministic, int asyncDepth, int sampleBatch, typename PoolStrategy, typename Allocator,
+              std::size_t memoryBudget>
+    class PRRT<Scenario, maxThreads, reportStats, NNStrategy, insertBatch, deterministic, asyncDepth, sampleBatch,
+               PoolStrategy, Allocator, memoryBudget>::Worker
         : public WorkerStats<reportStats>
     {
         using Stats = WorkerStats<reportStats>;
@@ -245,7 +313,62 @@ namespace unc::robotics::mpt::impl::prrt {
         Scenario scenario_;
         RNG rng_;
 
-        ObjectPool<Node> nodePool_;
+        pool_strategy_t<Node, PoolStrategy, Allocator> nodePool_;
+        ObjectPool<GoalRecord, true, Alloc<GoalRecord>> goalPool_;
+        MemoryCharge<memoryBudget> charge_;
+
+        // nodes created by this worker that have not yet been
+        // inserted into the shared nearest neighbor structure.  Only
+        // used when insertBatch > 1.
+        Vector<Node*> unpublished_;
+
+        // the sample prepared by prepareSample(), and added to the
+        // tree by commitSample().  pendingParent_ is null when there
+        // is nothing to commit.
+        Node *pendingParent_{nullptr};
+        std::optional<State> pendingState_;
+        bool pendingGoal_{false};
+
+        // when the scenario provides linkAsync(), the worker keeps up
+        // to asyncDepth samples in flight.  Each sample waits on
+        // validAsync() (when provided) and then on linkAsync().
+        // Deterministic solving requires a fixed order of checks, and
+        // thus does not use the asynchronous methods.
+        static constexpr bool asyncLink = scenario_has_link_async_v<Scenario, State> && !deterministic;
+        static constexpr bool asyncValid = scenario_has_valid_async_v<Scenario, State>;
+
+        struct AsyncSample {
+            Node *parent_;
+            State state_;
+            scenario_valid_async_t<Scenario, State> valid_;
+            std::conditional_t<asyncLink, scenario_link_async_t<Scenario, State>, std::nullptr_t> link_;
+            bool linking_;
+
+            AsyncSample(Node *parent, State&& state)
+                : parent_(parent)
+                , state_(std::move(state))
+                , valid_()
+                , link_()
+                , linking_(false)
+            {
+            }
+        };
+
+        Vector<AsyncSample> inFlight_;
+
+        // the longest a worker blocks on a check in flight before
+        // checking its done function again.
+        static constexpr std::chrono::milliseconds kAsyncWaitSlice{1};
+
+        // the current batch of samples when sampleBatch > 1.  The
+        // states, and the states of their parents, are stored
+        // contiguously for the scenario's validBatch() and
+        // linkBatch().
+        static constexpr bool batched = sampleBatch > 1 && !asyncLink && !deterministic;
+        Vector<Node*> batchParents_;
+        Vector<State> batchStates_;
+        Vector<State> batchFrom_;
+        std::unique_ptr<bool[]> batchValid_;
 
     public:
         Worker(Worker&& other)
@@ -253,15 +376,50 @@ namespace unc::robotics::mpt::impl::prrt {
             , scenario_(other.scenario_)
             , rng_(other.rng_)
             , nodePool_(std::move(other.nodePool_))
+            , goalPool_(std::move(other.goalPool_))
+            , charge_(other.charge_)
+            , unpublished_(std::move(other.unpublished_))
+            , pendingParent_(other.pendingParent_)
+            , pendingState_(std::move(other.pendingState_))
+            , pendingGoal_(other.pendingGoal_)
+            , inFlight_(std::move(other.inFlight_))
+            , batchParents_(std::move(other.batchParents_))
+            , batchStates_(std::move(other.batchStates_))
+            , batchFrom_(std::move(other.batchFrom_))
+            , batchValid_(std::move(other.batchValid_))
         {
         }
 
         template <typename RNGSeed>
         Worker(unsigned no, const Scenario& scenario, const RNGSeed& seed)
             : no_(no)
-            , scenario_(scenario)
-            , rng_(seed)
+            , scenario_(workerScenario(scenario))
+            , rng_(deterministic ? workerRNG<RNG>(seed, no) : RNG(seed))
         {
+            if constexpr (insertBatch > 1)
+                unpublished_.reserve(insertBatch);
+            if constexpr (asyncLink)
+                inFlight_.reserve(asyncDepth);
+            if constexpr (batched) {
+                batchParents_.reserve(sampleBatch);
+                batchStates_.reserve(sampleBatch);
+                batchFrom_.reserve(sampleBatch);
+                batchValid_.reset(new bool[sampleBatch]);
+            }
+        }
+
+        // see PRRT::reset()
+        void reset() {
+            static_cast<Stats&>(*this) = Stats();
+            nodePool_.clear();
+            goalPool_.clear();
+            unpublished_.clear();
+            pendingParent_ = nullptr;
+            pendingState_.reset();
+            inFlight_.clear();
+            batchParents_.clear();
+            batchStates_.clear();
+            batchFrom_.clear();
         }
 
         // decltype(auto) to allow both 'Space' and 'const Space&'
@@ -274,6 +432,20 @@ namespace unc::robotics::mpt::impl::prrt {
         void solve(Planner& planner, DoneFn done) {
             MPT_LOG(TRACE) << "worker running";
 
+            // make sure all nodes are in the nearest neighbor
+            // structure (and counted by size()) when solve returns.
+            auto publishOnReturn = finally([&] { publish(planner); });
+
+            if constexpr (asyncLink) {
+                solveAsync(planner, done);
+                return;
+            }
+
+            if constexpr (batched) {
+                solveBatch(planner, done);
+                return;
+            }
+
             Sampler sampler(scenario_);
             using Goal = scenario_goal_t<Scenario>;
             if constexpr (goal_has_sampler_v<Goal>) {
@@ -290,7 +462,7 @@ namespace unc::robotics::mpt::impl::prrt {
 
                     while (!done()) {
                         Stats::countIteration();
-                        if (planner.goalCount_.load(std::memory_order_relaxed) >= 1)
+                        if (planner.solved())
                             goto unbiasedSamplingLoop;
                         if (uniform01(rng_) < planner.goalBias_) {
                             Stats::countBiasedSample();
@@ -312,17 +484,237 @@ namespace unc::robotics::mpt::impl::prrt {
             MPT_LOG(TRACE) << "worker done";
         }
 
+        template <typename DoneFn>
+        void solveAsync(Planner& planner, DoneFn& done) {
+            Sampler sampler(scenario_);
+            while (!done()) {
+                if (inFlight_.size() < std::size_t(asyncDepth)) {
+                    Stats::countIteration();
+                    startAsync(planner, drawSample(planner, sampler));
+                    pollAsync(planner, false);
+                } else {
+                    pollAsync(planner, true);
+                }
+            }
+
+            // commit the checks that have already finished, and
+            // abandon the rest without waiting on them, so that a
+            // deadline is not overshot by the checks in flight.  The
+            // scenario copies the states it checks, thus it does not
+            // matter that they are freed first.
+            advanceAsync(planner, false);
+            inFlight_.clear();
+        }
+
+        // draws a sample from the goal (with goal bias, on worker 0,
+        // until solved) or from the sampler.
+        std::optional<State> drawSample(Planner& planner, Sampler& sampler) {
+            using Goal = scenario_goal_t<Scenario>;
+            if constexpr (goal_has_sampler_v<Goal>) {
+                if (no_ == 0 && planner.goalBias_ > 0 && !planner.solved()) {
+                    std::uniform_real_distribution<Distance> uniform01;
+                    if (uniform01(rng_) < planner.goalBias_) {
+                        Stats::countBiasedSample();
+                        GoalSampler<Goal> goalSampler(scenario_.goal());
+                        return goalSampler(rng_);
+                    }
+                }
+            }
+            return sampler(rng_);
+        }
+
+        template <typename DoneFn>
+        void solveBatch(Planner& planner, DoneFn& done) {
+            Sampler sampler(scenario_);
+            while (!done()) {
+                batchParents_.clear();
+                batchStates_.clear();
+
+                // draw the samples and find their nearest neighbors
+                for (int i=0 ; i<sampleBatch ; ++i) {
+                    Stats::countIteration();
+                    if (auto q = drawSample(planner, sampler)) {
+                        auto [nearNode, d] = nearest(planner, *q).value();
+                        if (d == 0)
+                            continue;
+                        if (d > planner.maxDistance_)
+                            q = interpolate(
+                                scenario_.space(),
+                                nearNode->state(), *q,
+                                planner.maxDistance_ / d);
+                        batchParents_.push_back(nearNode);
+                        batchStates_.push_back(std::move(*q));
+                    }
+                }
+
+                // check the states together
+                std::size_t n = batchStates_.size();
+                validBatch(scenario_, batchStates_.data(), n, batchValid_.get());
+
+                // keep the valid states, and check their motions
+                // together
+                std::size_t m = 0;
+                batchFrom_.clear();
+                for (std::size_t i=0 ; i<n ; ++i) {
+                    if (!batchValid_[i])
+                        continue;
+                    if (m != i) {
+                        batchParents_[m] = batchParents_[i];
+                        batchStates_[m] = std::move(batchStates_[i]);
+                    }
+                    batchFrom_.push_back(batchParents_[m++]->state());
+                }
+                {
+                    Timer timer(Stats::validMotion());
+                    validMotionBatch(scenario_, batchFrom_.data(), batchStates_.data(), m, batchValid_.get());
+                }
+
+                // then add to the tree
+                for (std::size_t i=0 ; i<m ; ++i) {
+                    if (!batchValid_[i])
+                        continue;
+
+                    pendingGoal_ = scenario_.goal()(scenario_.space(), batchStates_[i]).first;
+                    pendingParent_ = batchParents_[i];
+                    pendingState_ = std::move(batchStates_[i]);
+                    commitSample(planner);
+                }
+            }
+        }
+
+        void startAsync(Planner& planner, std::optional<State>&& sample) {
+            if (sample)
+                startAsync(planner, *sample);
+        }
+
+        // the same as prepareSample(), except that the checks are
+        // started and left in flight.
+        void startAsync(Planner& planner, State& randState) {
+            auto [nearNode, d] = nearest(planner, randState).value();
+            if (d == 0)
+                return;
+
+            State newState = randState;
+            if (d > planner.maxDistance_)
+                newState = interpolate(
+                    scenario_.space(),
+                    nearNode->state(), randState,
+                    planner.maxDistance_ / d);
+
+            if constexpr (asyncValid) {
+                inFlight_.emplace_back(nearNode, std::move(newState));
+                inFlight_.back().valid_ = scenario_.validAsync(inFlight_.back().state_);
+            } else {
+                if (!scenario_.valid(newState))
+                    return;
+                startLink(inFlight_.emplace_back(nearNode, std::move(newState)));
+            }
+        }
+
+        void startLink(AsyncSample& sample) {
+            sample.linking_ = true;
+            sample.link_ = scenario_.linkAsync(sample.parent_->state(), sample.state_);
+        }
+
+        // advances the samples in flight that have results.  When
+        // wait is true and no results are ready, this first waits for
+        // the result of the oldest sample.
+        void pollAsync(Planner& planner, bool wait) {
+            if (advanceAsync(planner) == 0 && wait && !inFlight_.empty()) {
+                Timer timer(Stats::asyncWait());
+                // wait in slices so that the caller checks its done
+                // function while the oldest check is still running.
+                AsyncSample& sample = inFlight_.front();
+                if (sample.linking_)
+                    sample.link_.wait_for(kAsyncWaitSlice);
+                else
+                    sample.valid_.wait_for(kAsyncWaitSlice);
+                advanceAsync(planner);
+            }
+        }
+
+        // commits or drops the samples whose checks have finished.
+        // When startLinks is false, samples that finish their
+        // validity check are dropped instead of starting a link.
+        std::size_t advanceAsync(Planner& planner, bool startLinks = true) {
+            std::size_t advanced = 0;
+            for (std::size_t i = 0 ; i < inFlight_.size() ; ) {
+                AsyncSample& sample = inFlight_[i];
+                if (!(sample.linking_ ? asyncReady(sample.link_) : asyncReady(sample.valid_))) {
+                    ++i;
+                    continue;
+                }
+
+                ++advanced;
+                if (!sample.linking_) {
+                    if (sample.valid_.get() && startLinks) {
+                        startLink(sample);
+                        ++i;
+                        continue;
+                    }
+                } else if (sample.link_.get()) {
+                    pendingGoal_ = scenario_.goal()(scenario_.space(), sample.state_).first;
+                    pendingParent_ = sample.parent_;
+                    pendingState_ = std::move(sample.state_);
+                    commitSample(planner);
+                }
+
+                // remove the completed sample, keeping the rest
+                // in the order they started.
+                inFlight_.erase(inFlight_.begin() + i);
+            }
+            return advanced;
+        }
+
+        // prepares one sample for a round of deterministic solving.
+        // This matches an iteration of solve(), but does not modify
+        // the tree, so that all workers can prepare concurrently.
+        void prepare(Planner& planner) {
+            Stats::countIteration();
+            pendingParent_ = nullptr;
+            Sampler sampler(scenario_);
+            prepareSample(planner, drawSample(planner, sampler));
+        }
+
+        void commit(Planner& planner) {
+            commitSample(planner);
+        }
+
         void addSample(Planner& planner, std::optional<State>&& sample) {
             if (sample)
                 addSample(planner, *sample);
         }
 
-        decltype(auto) nearest(Planner& planner, const State& state) {
+        void addSample(Planner& planner, State& randState) {
+            pendingParent_ = nullptr;
+            prepareSample(planner, randState);
+            commitSample(planner);
+        }
+
+        auto nearest(Planner& planner, const State& state) {
             Timer timer(Stats::nearest());
-            return planner.nn_.nearest(state);
+            auto nbr = planner.nn_.nearest(state);
+            if constexpr (insertBatch > 1) {
+                for (Node *n : unpublished_) {
+                    Distance d = scenario_.space().distance(n->state(), state);
+                    if (!nbr || d < nbr->second)
+                        nbr = std::make_pair(n, d);
+                }
+            }
+            return nbr;
         }
 
-        void addSample(Planner& planner, State& randState) {
+        void publish(Planner& planner) {
+            nnInsert(planner.nn_, unpublished_.begin(), unpublished_.end());
+            unpublished_.clear();
+        }
+
+        void prepareSample(Planner& planner, std::optional<State>&& sample) {
+            if (sample)
+                prepareSample(planner, *sample);
+        }
+
+        void prepareSample(Planner& planner, State& randState) {
             // nearest returns an optional, however it will
             // only be empty if the nn structure is empty,
             // which it will not be, because the planner's
@@ -359,11 +751,58 @@ namespace unc::robotics::mpt::impl::prrt {
             auto [isGoal, goalDist] = scenario_.goal()(scenario_.space(), newState);
             (void)goalDist; // mark unused (for now, may be used in approx solutions)
 
-            Node* newNode = nodePool_.allocate(nearNode, newState);
-            planner.nn_.insert(newNode);
+            pendingParent_ = nearNode;
+            pendingState_ = std::move(newState);
+            pendingGoal_ = isGoal;
+        }
+
+        void commitSample(Planner& planner) {
+            if (pendingParent_ == nullptr)
+                return;
+
+            Node* newNode = nodePool_.allocate(pendingParent_, *pendingState_);
+            pendingParent_ = nullptr;
+            if constexpr (insertBatch > 1) {
+                unpublished_.push_back(newNode);
+                if (unpublished_.size() >= std::size_t(insertBatch))
+                    publish(planner);
+            } else {
+                planner.nn_.insert(newNode);
+            }
+
+            if (pendingGoal_)
+                planner.foundGoal(goalPool_.allocate(newNode, pathCost(newNode)));
+
+            if constexpr (memoryBudget != 0)
+                charge_.update(planner.budget_, memoryUsed());
+        }
+
+        // the bytes used by this worker's pools and its share of the
+        // nearest neighbor structure.
+        std::size_t memoryUsed() const {
+            return nodePool_.bytes() + goalPool_.bytes() + nodePool_.size() * kNNBytesPerEntry;
+        }
+
+        MemoryStats memoryStats() const {
+            MemoryStats stats;
+            stats.addPool("nodes", nodePool_);
+            stats.addPool("goals", goalPool_);
+            stats.addVector("unpublished nodes", unpublished_);
+            stats.addVector("in-flight samples", inFlight_);
+            stats.addVector("sample batch", batchParents_);
+            stats.addVector("sample batch", batchStates_);
+            stats.addVector("sample batch", batchFrom_);
+            return stats;
+        }
 
-            if (isGoal)
-                planner.foundGoal(newNode);
+        // computes the cost of the path from the start to the node.
+        // This is only needed when a goal is found, and thus is not
+        // stored in every node.
+        Distance pathCost(const Node *n) const {
+            Distance cost = 0;
+            for (const Node *p ; (p = n->parent()) != nullptr ; n = p)
+                cost += scenario_.space().distance(n->state(), p->state());
+            return cost;
         }
 
         bool validMotion(const State& a, const State& b) {
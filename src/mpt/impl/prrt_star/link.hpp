@@ -38,24 +38,33 @@
 #define MPT_IMPL_PRRT_STAR_LINK_HPP
 
 #include "node.hpp"
+#include "../cas_stat.hpp"
+#include "../compact_ptr.hpp"
 #include <atomic>
 #include <cassert>
 
 namespace unc::robotics::mpt::impl::prrt_star {
-    template <typename State, typename Distance, bool concurrent>
+    template <typename State, typename Distance, bool concurrent, bool compact>
     class Link;
 
-    // Specialization of Link for concurrent RRT*
-    template <typename State, typename Distance>
-    class Link<State, Distance, true> {
-        using Node = prrt_star::Node<State, Distance, true>;
-
-        Node *node_;
-        Link *parent_;
+    // Specialization of Link for concurrent RRT*.  The link records
+    // its parent's node instead of the parent's link, since the
+    // parent's link may be superseded, and then reclaimed and
+    // reused.  Links must remain trivially destructible so that a
+    // reclaimed link can be reused by constructing over it.  When
+    // compact is true, the node and link pointers are 32-bit
+    // CompactPtrs, and nodes and links must be allocated from
+    // CompactPools.
+    template <typename State, typename Distance, bool compact>
+    class Link<State, Distance, true, compact> {
+        using Node = prrt_star::Node<State, Distance, true, compact>;
+
+        cptr_t<Node, compact> node_;
+        cptr_t<Node, compact> parent_;
         Distance cost_;
 
-        std::atomic<Link*> firstChild_{nullptr};
-        std::atomic<Link*> nextSibling_{nullptr};
+        atomic_cptr_t<Link, compact> firstChild_{nullptr};
+        atomic_cptr_t<Link, compact> nextSibling_{nullptr};
 
     public:
         Link(const Link&) = delete;
@@ -66,16 +75,32 @@ namespace unc::robotics::mpt::impl::prrt_star {
         {
         }
 
-        Link(Node *node, Link *parent, Distance cost)
-            : node_(node), parent_(parent), cost_(cost)
+        // Creates the link, and adds it to the parent's children.
+        // The number of retries in the push onto the parent's child
+        // list is counted in stat.
+        template <bool enableStat = false>
+        Link(Node *node, Link *parent, Distance cost, CASStat<enableStat>& stat = CASStat<false>::instance())
+            : node_(node), parent_(parent->node()), cost_(cost)
         {
-            Link *next = parent->firstChild_.load(std::memory_order_relaxed);
-            do {
-                nextSibling_.store(next, std::memory_order_relaxed);
-            } while (!parent->firstChild_.compare_exchange_weak(
-                         next, this,
-                         std::memory_order_release,
-                         std::memory_order_relaxed));
+            parent->pushChild(this, stat);
+        }
+
+        // Adds child to this link's children.  The child must not be
+        // on any other child list.
+        template <bool enableStat = false>
+        void pushChild(Link *child, CASStat<enableStat>& stat = CASStat<false>::instance()) {
+            unsigned retries = 0;
+            Link *next = firstChild_.load(std::memory_order_relaxed);
+            for (;;) {
+                child->nextSibling_.store(next, std::memory_order_relaxed);
+                if (firstChild_.compare_exchange_weak(
+                        next, child,
+                        std::memory_order_release,
+                        std::memory_order_relaxed))
+                    break;
+                ++retries;
+            }
+            stat += retries;
         }
 
         Node* node() {
@@ -90,7 +115,7 @@ namespace unc::robotics::mpt::impl::prrt_star {
             return cost_;
         }
 
-        const Link *parent() const {
+        Node *parentNode() const {
             return parent_;
         }
 
@@ -112,15 +137,15 @@ namespace unc::robotics::mpt::impl::prrt_star {
     // are stored in the Node instead of allocated separately.  To
     // store it in the node and make it easy to traverse between the
     // two, Link is base class of Node.
-    template <typename State, typename Distance>
-    class Link<State, Distance, false> {
-        using Node = prrt_star::Node<State, Distance, false>;
+    template <typename State, typename Distance, bool compact>
+    class Link<State, Distance, false, compact> {
+        using Node = prrt_star::Node<State, Distance, false, compact>;
 
-        Link *parent_;
+        cptr_t<Link, compact> parent_;
         Distance cost_;
 
-        Link *firstChild_{nullptr};
-        Link *nextSibling_;
+        cptr_t<Link, compact> firstChild_{nullptr};
+        cptr_t<Link, compact> nextSibling_;
 
     protected:
         Link(const Link&) = delete;
@@ -163,6 +188,10 @@ namespace unc::robotics::mpt::impl::prrt_star {
             return parent_;
         }
 
+        const Node *parentNode() const {
+            return parent_ ? parent_->node() : nullptr;
+        }
+
         void setParent(Link *newParent) {
             assert(newParent != nullptr && newParent->cost() <= cost_ && newParent != parent_);
 
@@ -40,12 +40,12 @@
 #include "../atom.hpp"
 
 namespace unc::robotics::mpt::impl::prrt_star {
-    template <typename State, typename Distance, bool concurrent>
+    template <typename State, typename Distance, bool concurrent, bool compact>
     class Link;
 
-    template <typename State, typename Distance, bool concurrent>
+    template <typename State, typename Distance, bool concurrent, bool compact>
     class Node {
-        using Link = prrt_star::Link<State, Distance, concurrent>;
+        using Link = prrt_star::Link<State, Distance, concurrent, compact>;
 
         State state_;
         Atom<Link*, concurrent> link_{nullptr};
@@ -85,12 +85,12 @@ namespace unc::robotics::mpt::impl::prrt_star {
         }
     };
 
-    template <typename State, typename Distance>
-    class Node<State, Distance, false>
-        : prrt_star::Link<State, Distance, false>
+    template <typename State, typename Distance, bool compact>
+    class Node<State, Distance, false, compact>
+        : prrt_star::Link<State, Distance, false, compact>
     {
-        using Link = prrt_star::Link<State, Distance, false>;
-        friend class prrt_star::Link<State, Distance, false>;
+        using Link = prrt_star::Link<State, Distance, false, compact>;
+        friend class prrt_star::Link<State, Distance, false, compact>;
 
         State state_;
         bool goal_;
@@ -130,8 +130,8 @@ namespace unc::robotics::mpt::impl::prrt_star {
     };
 
     struct NodeKey {
-        template <typename State, typename Distance, bool concurrent>
-        const State& operator() (const Node<State, Distance, concurrent>* node) const {
+        template <typename State, typename Distance, bool concurrent, bool compact>
+        const State& operator() (const Node<State, Distance, concurrent, compact>* node) const {
             return node->state();
         }
     };
@@ -41,21 +41,32 @@
 #include "link.hpp"
 #include "node.hpp"
 #include "../atom.hpp"
+#include "../cas_stat.hpp"
 #include "../constants.hpp"
+#include "../epoch.hpp"
 #include "../goal_has_sampler.hpp"
+#include "../memory_budget.hpp"
+#include "../memory_stats.hpp"
 #include "../object_pool.hpp"
 #include "../planner_base.hpp"
+#include "../pool_strategy.hpp"
 #include "../scenario_goal.hpp"
 #include "../scenario_rng.hpp"
 #include "../scenario_sampler.hpp"
+#include "../scenario_shared.hpp"
 #include "../scenario_space.hpp"
+#include "../scenario_valid_batch.hpp"
 #include "../timer_stat.hpp"
 #include "../worker_pool.hpp"
+#include "../worker_seed.hpp"
+#include "../../fixed_seed.hpp"
 #include "../../log.hpp"
 #include "../../random_device_seed.hpp"
 #include <nigh/nigh_forward.hpp>
 #include <forward_list>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <omp.h>
 #include <optional>
 #include <queue>
@@ -110,6 +121,12 @@ namespace unc::robotics::mpt::impl::prrt_star {
         auto& validMotion() { return TimerStat<void>::instance(); }
         auto& nearest1() { return TimerStat<void>::instance(); }
         auto& nearestK() { return TimerStat<void>::instance(); }
+        auto& setLinkCAS() { return CASStat<false>::instance(); }
+        auto& solutionCAS() { return CASStat<false>::instance(); }
+        auto& detachCAS() { return CASStat<false>::instance(); }
+        auto& childPushCAS() { return CASStat<false>::instance(); }
+        void retiredLink() const {}
+        void reusedLink() const {}
     };
 
     template <>
@@ -121,6 +138,12 @@ namespace unc::robotics::mpt::impl::prrt_star {
         mutable TimerStat<> validMotion_;
         mutable TimerStat<> nearest1_;
         mutable TimerStat<> nearestK_;
+        mutable CASStat<> setLinkCAS_;
+        mutable CASStat<> solutionCAS_;
+        mutable CASStat<> detachCAS_;
+        mutable CASStat<> childPushCAS_;
+        mutable std::size_t retiredLinks_{0};
+        mutable std::size_t reusedLinks_{0};
 
         void iteration() const { ++iterations_; };
         void biasedSample() const { ++biasedSamples_; }
@@ -129,6 +152,12 @@ namespace unc::robotics::mpt::impl::prrt_star {
         TimerStat<>& validMotion() const { return validMotion_; }
         TimerStat<>& nearest1() const { return nearest1_; }
         TimerStat<>& nearestK() const { return nearestK_; }
+        CASStat<>& setLinkCAS() const { return setLinkCAS_; }
+        CASStat<>& solutionCAS() const { return solutionCAS_; }
+        CASStat<>& detachCAS() const { return detachCAS_; }
+        CASStat<>& childPushCAS() const { return childPushCAS_; }
+        void retiredLink() const { ++retiredLinks_; }
+        void reusedLink() const { ++reusedLinks_; }
 
         WorkerStats& operator += (const WorkerStats& other) {
             iterations_ += other.iterations_;
@@ -138,6 +167,12 @@ namespace unc::robotics::mpt::impl::prrt_star {
             validMotion_ += other.validMotion_;
             nearest1_ += other.nearest1_;
             nearestK_ += other.nearestK_;
+            setLinkCAS_ += other.setLinkCAS_;
+            solutionCAS_ += other.solutionCAS_;
+            detachCAS_ += other.detachCAS_;
+            childPushCAS_ += other.childPushCAS_;
+            retiredLinks_ += other.retiredLinks_;
+            reusedLinks_ += other.reusedLinks_;
             return *this;
         }
 
@@ -148,23 +183,40 @@ namespace unc::robotics::mpt::impl::prrt_star {
             MPT_LOG(INFO) << "valid motion: " << validMotion_;
             MPT_LOG(INFO) << "nearest 1: " << nearest1_;
             MPT_LOG(INFO) << "nearest K: " << nearestK_;
+            MPT_LOG(INFO) << "set link CAS: " << setLinkCAS_;
+            MPT_LOG(INFO) << "update solution CAS: " << solutionCAS_;
+            MPT_LOG(INFO) << "detach children CAS: " << detachCAS_;
+            MPT_LOG(INFO) << "link child push CAS: " << childPushCAS_;
+            MPT_LOG(INFO) << "links retired: " << retiredLinks_ << ", reused: " << reusedLinks_;
         }
     };
 
-    template <typename Scenario, int maxThreads, bool kNearest, bool reportStats, typename NNStrategy>
-    class PRRTStar : public PlannerBase<PRRTStar<Scenario, maxThreads, kNearest, reportStats, NNStrategy>> {
+    template <typename Scenario, int maxThreads, bool kNearest, bool reportStats, typename NNStrategy,
+              bool deterministic, int sampleBatch, typename PoolStrategy, typename Allocator,
+              std::size_t memoryBudget>
+    class PRRTStar : public PlannerBase<PRRTStar<
+        Scenario, maxThreads, kNearest, reportStats, NNStrategy, deterministic, sampleBatch,
+        PoolStrategy, Allocator, memoryBudget>>
+    {
         using Planner = PRRTStar;
         using Base = PlannerBase<Planner>;
         using Space = scenario_space_t<Scenario>;
         using State = typename Space::Type;
         using Distance = typename Space::Distance;
         static constexpr bool concurrent = maxThreads != 1;
-        using Link = prrt_star::Link<State, Distance, concurrent>;
-        using Node = prrt_star::Node<State, Distance, concurrent>;
+        static constexpr bool compactGraph = is_compact_v<PoolStrategy>;
+        using Link = prrt_star::Link<State, Distance, concurrent, compactGraph>;
+        using Node = prrt_star::Node<State, Distance, concurrent, compactGraph>;
         using RNG = scenario_rng_t<Scenario, Distance>;
         using Sampler = scenario_sampler_t<Scenario, RNG>;
         using Clock = std::chrono::steady_clock;
 
+        // the configured allocator, rebound to each type allocated
+        template <typename T>
+        using Alloc = rebind_alloc_t<Allocator, T>;
+        template <typename T>
+        using Vector = std::vector<T, Alloc<T>>;
+
         Distance maxDistance_{std::numeric_limits<Distance>::infinity()};
         Distance goalBias_{0.01};
         Distance rewireFactor_{1.1};
@@ -174,7 +226,7 @@ namespace unc::robotics::mpt::impl::prrt_star {
         std::size_t maxGoals_{1};
 
         using NNConcurrency = std::conditional_t<concurrent, nigh::Concurrent, nigh::NoThreadSafety>;
-        nigh::Nigh<Node*, Space, NodeKey, NNConcurrency, NNStrategy> nn_;
+        nigh::Nigh<Node*, Space, NodeKey, NNConcurrency, NNStrategy, Alloc<Node*>> nn_;
 
         alignas(concurrent ? 64 : 0)
         Atom<Link*, concurrent> solution_{nullptr};
@@ -182,12 +234,20 @@ namespace unc::robotics::mpt::impl::prrt_star {
         Atom<std::size_t, concurrent> goalCount_{0};
 
         std::mutex startNodeMutex_;
-        ObjectPool<Node, false> startNodes_;
-        ObjectPool<Link, false> startLinks_;
+        start_pool_t<Node, PoolStrategy, Allocator> startNodes_;
+        start_pool_t<Link, PoolStrategy, Allocator> startLinks_;
 
         struct Worker;
 
-        WorkerPool<Worker, maxThreads> workers_;
+        WorkerPool<Worker, maxThreads, Alloc<Worker>> workers_;
+
+        // superseded links are retired to the worker that removed
+        // them from the tree, and reused once no worker can still
+        // reference them.  Goal links are never retired, since
+        // solution_ may point to them.
+        EpochDomain<concurrent> epochs_;
+
+        MemoryBudget<memoryBudget> budget_;
 
         Clock::time_point solveStartTime_;
 
@@ -222,10 +282,11 @@ namespace unc::robotics::mpt::impl::prrt_star {
 
     public:
         // required constructor
-        template <typename RNGSeed = RandomDeviceSeed<>>
+        template <typename RNGSeed = std::conditional_t<deterministic, FixedSeed, RandomDeviceSeed<>>>
         explicit PRRTStar(const Scenario& scenario = Scenario(), const RNGSeed& seed = RNGSeed())
             : nn_(scenario.space())
             , workers_(scenario, seed)
+            , epochs_(workers_.size())
         {
             calculateRewiringLowerBounds();
 
@@ -272,6 +333,22 @@ namespace unc::robotics::mpt::impl::prrt_star {
             nn_.insert(node);
         }
 
+        // Removes all nodes, including the start states, so that the
+        // planner can be reused for another query.  Unlike
+        // constructing a new planner, the workers keep their scenario
+        // copies, random number generators, and the storage of their
+        // pools and buffers.  Worker stats are cleared.  Must not be
+        // called while solving.
+        void reset() {
+            nn_.clear();
+            solution_.store(nullptr, std::memory_order_relaxed);
+            goalCount_.store(0, std::memory_order_relaxed);
+            startNodes_.clear();
+            startLinks_.clear();
+            for (unsigned i=0 ; i<workers_.size() ; ++i)
+                workers_[i].reset();
+        }
+
         // required to get convenience methods
         using Base::solveFor;
         using Base::solveUntil;
@@ -291,7 +368,12 @@ namespace unc::robotics::mpt::impl::prrt_star {
 
             solveStartTime_ = Clock::now();
 
-            workers_.solve(*this, doneFn);
+            auto budgetDoneFn = budget_.doneFn(workers_.size(), std::move(doneFn));
+
+            if constexpr (deterministic)
+                workers_.solveRounds(*this, budgetDoneFn);
+            else
+                workers_.solve(*this, budgetDoneFn);
 
             if constexpr (reportStats) {
                 MPT_LOG(DEBUG) << "final k-nearest value of " << rewireCount();
@@ -302,39 +384,97 @@ namespace unc::robotics::mpt::impl::prrt_star {
             }
         }
 
+        // the bytes charged to the memory budget (0 without a
+        // memory_budget)
+        std::size_t memoryUsed() const {
+            return budget_.used();
+        }
+
+        // true when the last solve() stopped because of the memory
+        // budget.
+        bool memoryBudgetReached() const {
+            return budget_.reached();
+        }
+
         // required method
         bool solved() const {
             return solution_.load(std::memory_order_relaxed) != nullptr;
         }
 
-        // prototype method
+        // prototype method.  While solving, this may only be called
+        // from the done function, as links may otherwise be reused
+        // while the path is followed.
         std::vector<State> solution() const {
             std::vector<State> path;
             if (const Link *link = solution_.load(std::memory_order_acquire)) {
                 for (;;) {
                     path.push_back(link->node()->state());
-                    if ((link = link->parent()) == nullptr)
+                    const Node *parent = link->parentNode();
+                    if (parent == nullptr)
                         break;
-                    link = link->node()->link(std::memory_order_acquire);
+                    link = parent->link(std::memory_order_acquire);
                 }
                 std::reverse(path.begin(), path.end());
             }
             return path;
         }
 
-        void printStats() {
-            MPT_LOG(INFO) << "nodes in graph: " << nn_.size();
+        // the memory used by the planner's pools and buffers, summed
+        // over the workers.  Superseded links are reported apart from
+        // the links in the tree.  They are waiting to be reused (see
+        // Worker::retireLink()), thus their count should stay bounded
+        // as the tree grows.  Since a worker may retire links that
+        // other workers allocated, they are only split out here.
+        MemoryStats memoryStats() const {
+            MemoryStats stats;
+            stats.add("nn index (estimate)", nn_.size(), nn_.size() * kNNBytesPerEntry);
+            stats.addPool("start nodes", startNodes_);
+            stats.addPool("start links", startLinks_);
+            std::size_t superseded = 0;
+            for (unsigned i=0 ; i<workers_.size() ; ++i) {
+                stats += workers_[i].memoryStats();
+                superseded += workers_[i].supersededLinks();
+            }
+            stats.move("links", "superseded links", superseded, superseded * sizeof(Link));
+            return stats;
+        }
+
+        // the memory used by one worker's pools and buffers, in which
+        // "links" counts all the links the worker allocated.
+        MemoryStats memoryStats(unsigned worker) const {
+            return workers_[worker].memoryStats();
+        }
+
+        // the number of workers, for memoryStats(worker).
+        unsigned workerCount() const {
+            return workers_.size();
+        }
+
+        // the workers' stats, summed.  Empty unless reportStats.
+        WorkerStats<reportStats> stats() const {
+            WorkerStats<reportStats> stats;
             if constexpr (reportStats) {
-                WorkerStats<true> stats;
                 for (unsigned i=0 ; i<workers_.size() ; ++i)
                     stats += workers_[i];
-                stats.print();
             }
+            return stats;
+        }
+
+        void printStats() {
+            MPT_LOG(INFO) << "nodes in graph: " << nn_.size();
+            if constexpr (reportStats)
+                stats().print();
+            for (unsigned i=0 ; i<workers_.size() ; ++i)
+                memoryStats(i).print("worker " + std::to_string(i));
+            memoryStats().print("planner");
         }
     };
 
-    template <typename Scenario, int maxThreads, bool kNearest, bool reportStats, typename NNStrategy>
-    class PRRTStar<Scenario, maxThreads, kNearest, reportStats, NNStrategy>::Worker
+    template <typename Scenario, int maxThreads, bool kNearest, bool reportStats, typename NNStrategy,
+              bool deterministic, int sampleBatch, typename PoolStrategy, typename Allocator,
+              std::size_t memoryBudget>
+    class PRRTStar<Scenario, maxThreads, kNearest, reportStats, NNStrategy, deterministic, sampleBatch,
+                   PoolStrategy, Allocator, memoryBudget>::Worker
         : public WorkerStats<reportStats>
     {
         using Stats = WorkerStats<reportStats>;
@@ -343,26 +483,86 @@ namespace unc::robotics::mpt::impl::prrt_star {
         Scenario scenario_;
         RNG rng_;
 
-        ObjectPool<Node> nodes_;
-        ObjectPool<Link> links_;
-
-        std::vector<std::tuple<Node*, Distance>> nbh_;
-        std::vector<std::tuple<Link*, std::size_t>> linkIndices_;
+        pool_strategy_t<Node, PoolStrategy, Allocator> nodes_;
+        pool_strategy_t<Link, PoolStrategy, Allocator> links_;
+        MemoryCharge<memoryBudget> charge_;
+
+        // links that this worker removed from the tree, waiting
+        // until they can be reused.  See retireLink().
+        static constexpr std::size_t kReclaimThreshold = 64;
+        EpochLimbo<Link, Alloc<Link*>> linkLimbo_;
+
+        Vector<std::tuple<Node*, Distance>> nbh_;
+        Vector<std::tuple<Link*, std::size_t>> linkIndices_;
+
+        // the sample prepared by prepareSample() and added to the
+        // tree by commitSample().  The parent is recorded by node
+        // since its link may be replaced before the commit.  The
+        // rewiring candidates are left in nbh_, with the candidates
+        // that were checked, or have an invalid motion, set to null.
+        // pendingParent_ is null when there is nothing to commit.
+        Node *pendingParent_{nullptr};
+        Distance pendingParentDist_{0};
+        std::optional<State> pendingState_;
+        bool pendingGoal_{false};
+
+        // the current batch of samples when sampleBatch > 1, with
+        // the states and the states of their nearest nodes stored
+        // contiguously for validBatch() and linkBatch().
+        static constexpr bool batched = sampleBatch > 1 && !deterministic;
+        Vector<std::tuple<Node*, Distance>> batchNear_;
+        Vector<State> batchStates_;
+        Vector<State> batchFrom_;
+        std::unique_ptr<bool[]> batchValid_;
 
     public:
         Worker(Worker&& other)
-            : scenario_(other.scenario_)
+            : Stats(std::move(other))
+            , no_(other.no_)
+            , scenario_(std::move(other.scenario_))
+            , rng_(std::move(other.rng_))
             , nodes_(std::move(other.nodes_))
             , links_(std::move(other.links_))
+            , charge_(other.charge_)
+            , linkLimbo_(std::move(other.linkLimbo_))
+            , pendingParent_(other.pendingParent_)
+            , pendingParentDist_(other.pendingParentDist_)
+            , pendingState_(std::move(other.pendingState_))
+            , pendingGoal_(other.pendingGoal_)
+            , batchNear_(std::move(other.batchNear_))
+            , batchStates_(std::move(other.batchStates_))
+            , batchFrom_(std::move(other.batchFrom_))
+            , batchValid_(std::move(other.batchValid_))
         {
         }
 
         template <typename RNGSeed>
         Worker(unsigned no, const Scenario& scenario, const RNGSeed& seed)
             : no_(no)
-            , scenario_(scenario)
-            , rng_(seed)
+            , scenario_(workerScenario(scenario))
+            , rng_(deterministic ? workerRNG<RNG>(seed, no) : RNG(seed))
         {
+            if constexpr (batched) {
+                batchNear_.reserve(sampleBatch);
+                batchStates_.reserve(sampleBatch);
+                batchFrom_.reserve(sampleBatch);
+                batchValid_.reset(new bool[sampleBatch]);
+            }
+        }
+
+        // see PRRTStar::reset()
+        void reset() {
+            static_cast<Stats&>(*this) = Stats();
+            nodes_.clear();
+            links_.clear();
+            linkLimbo_.clear();
+            nbh_.clear();
+            linkIndices_.clear();
+            pendingParent_ = nullptr;
+            pendingState_.reset();
+            batchNear_.clear();
+            batchStates_.clear();
+            batchFrom_.clear();
         }
 
         decltype(auto) space() const {
@@ -378,6 +578,18 @@ namespace unc::robotics::mpt::impl::prrt_star {
             // using namespace std::literals;
             // typename Clock::duration nextProgress = 1s;
 
+            // done() may follow links (e.g., by calling solution()),
+            // thus it is called from within the epoch.
+            auto epochDone = [&] {
+                EpochGuard<concurrent> guard(planner.epochs_, no_);
+                return done();
+            };
+
+            if constexpr (batched) {
+                solveBatch(planner, epochDone);
+                return;
+            }
+
             Sampler sampler(scenario_);
             using Goal = scenario_goal_t<Scenario>;
             if constexpr (goal_has_sampler_v<Goal>) {
@@ -392,7 +604,7 @@ namespace unc::robotics::mpt::impl::prrt_star {
 
                     MPT_LOG(TRACE) << "using scaled goal bias of " << scaledBias;
 
-                    while (!done()) {
+                    while (!epochDone()) {
                         Stats::iteration();
                         // if ((Clock::now() - planner.solveStartTime_) > nextProgress) {
                         //     MPT_LOG(TRACE) << "size = " << planner.size() << ", biased samples = " << Stats::biasedSamples();
@@ -413,7 +625,7 @@ namespace unc::robotics::mpt::impl::prrt_star {
             }
 
           unbiasedSamplingLoop:
-            while (!done()) {
+            while (!epochDone()) {
                 Stats::iteration();
                 addSample(planner, sampler(rng_));
             }
@@ -421,17 +633,124 @@ namespace unc::robotics::mpt::impl::prrt_star {
             MPT_LOG(TRACE) << "worker done";
         }
 
+        // prepares one sample for a round of deterministic solving.
+        // This matches an iteration of solve(), but does not modify
+        // the tree, so that all workers can prepare concurrently.
+        void prepare(Planner& planner) {
+            Stats::iteration();
+            pendingParent_ = nullptr;
+            Sampler sampler(scenario_);
+            EpochGuard<concurrent> guard(planner.epochs_, no_);
+            prepareSample(planner, drawSample(planner, sampler));
+        }
+
+        // draws a sample from the goal (with goal bias, on worker 0,
+        // until a goal is found) or from the sampler.
+        std::optional<State> drawSample(Planner& planner, Sampler& sampler) {
+            using Goal = scenario_goal_t<Scenario>;
+            if constexpr (goal_has_sampler_v<Goal>) {
+                if (no_ == 0 && planner.goalBias_ > 0 && planner.goalCount_.load(std::memory_order_relaxed) == 0) {
+                    std::uniform_real_distribution<Distance> uniform01;
+                    if (uniform01(rng_) < planner.goalBias_) {
+                        Stats::biasedSample();
+                        GoalSampler<Goal> goalSampler(scenario_.goal());
+                        return goalSampler(rng_);
+                    }
+                }
+            }
+            return sampler(rng_);
+        }
+
+        template <typename DoneFn>
+        void solveBatch(Planner& planner, DoneFn& done) {
+            Sampler sampler(scenario_);
+            while (!done()) {
+                EpochGuard<concurrent> guard(planner.epochs_, no_);
+                batchNear_.clear();
+                batchStates_.clear();
+
+                // draw the samples and find their nearest neighbors
+                for (int i=0 ; i<sampleBatch ; ++i) {
+                    Stats::iteration();
+                    if (auto q = drawSample(planner, sampler)) {
+                        auto [nearNode, dNear] = nearest(planner, *q).value();
+                        if (steer(planner, nearNode, dNear, *q)) {
+                            batchNear_.emplace_back(nearNode, dNear);
+                            batchStates_.push_back(std::move(*q));
+                        }
+                    }
+                }
+
+                // check the states together
+                std::size_t n = batchStates_.size();
+                validBatch(scenario_, batchStates_.data(), n, batchValid_.get());
+
+                // keep the valid states, and check their motions
+                // together
+                std::size_t m = 0;
+                batchFrom_.clear();
+                for (std::size_t i=0 ; i<n ; ++i) {
+                    if (!batchValid_[i])
+                        continue;
+                    if (m != i) {
+                        batchNear_[m] = batchNear_[i];
+                        batchStates_[m] = std::move(batchStates_[i]);
+                    }
+                    batchFrom_.push_back(std::get<Node*>(batchNear_[m++])->state());
+                }
+                {
+                    Timer timer(Stats::validMotion());
+                    validMotionBatch(scenario_, batchFrom_.data(), batchStates_.data(), m, batchValid_.get());
+                }
+
+                // then connect and rewire
+                for (std::size_t i=0 ; i<m ; ++i) {
+                    auto [nearNode, dNear] = batchNear_[i];
+                    if (!batchValid_[i])
+                        continue;
+                    pendingParent_ = nullptr;
+                    prepareConnect(planner, nearNode, dNear, batchStates_[i]);
+                    commitSample(planner);
+                }
+
+                reclaimLinks(planner);
+            }
+        }
+
+        void commit(Planner& planner) {
+            {
+                EpochGuard<concurrent> guard(planner.epochs_, no_);
+                commitSample(planner);
+            }
+            reclaimLinks(planner);
+        }
+
         void addSample(Planner& planner, std::optional<State>&& sample) {
             if (sample)
                 addSample(planner, *sample);
         }
 
+        void addSample(Planner& planner, State newState) {
+            {
+                EpochGuard<concurrent> guard(planner.epochs_, no_);
+                pendingParent_ = nullptr;
+                prepareSample(planner, newState);
+                commitSample(planner);
+            }
+            reclaimLinks(planner);
+        }
+
+        void prepareSample(Planner& planner, std::optional<State>&& sample) {
+            if (sample)
+                prepareSample(planner, *sample);
+        }
+
         decltype(auto) nearest(Planner& planner, const State& q) {
             Timer timer(Stats::nearest1());
             return planner.nn_.nearest(q);
         }
 
-        void addSample(Planner& planner, State newState) {
+        void prepareSample(Planner& planner, State& newState) {
             // MPT_LOG(TRACE) << "q = " << randState;
 
             // nearest returns an optional, however it will
@@ -439,7 +758,22 @@ namespace unc::robotics::mpt::impl::prrt_star {
             // which it will not be, because the planner's
             // solve checks first. (but we assert anyways)
             auto [nearNode, dNear] = nearest(planner, newState).value();
+            if (!steer(planner, nearNode, dNear, newState))
+                return;
 
+            // TODO: do not need to check when scenario returns
+            // std::optional<State> and the motion was not
+            // interpolated.
+            if (!validMotion<true>(nearNode->state(), newState))
+                return;
+
+            prepareConnect(planner, nearNode, dNear, newState);
+        }
+
+        // limits newState to the planner's range from nearNode,
+        // updating dNear to match.  Returns false if the sample
+        // should be discarded.
+        bool steer(Planner& planner, Node *nearNode, Distance& dNear, State& newState) {
             // avoid adding the same state multiple times.  Unfortunately
             // this check is not sufficient, and may need to be updated.
             // numeric issues may cause distance() to return a non-zero
@@ -448,7 +782,7 @@ namespace unc::robotics::mpt::impl::prrt_star {
             // distance--but this would cause other issues with the
             // planner and thus may not be worth handling.
             if (dNear == 0)
-                return;
+                return false;
 
             if (dNear > planner.maxDistance_) {
                 newState = interpolate(
@@ -459,17 +793,19 @@ namespace unc::robotics::mpt::impl::prrt_star {
                 dNear = scenario_.space().distance(nearNode->state(), newState);
             }
 
-            // TODO: do not need to check when scenario returns
-            // std::optional<State> and the motion was not
-            // interpolated.
-            if (!validMotion<true>(nearNode->state(), newState))
-                return;
+            return true;
+        }
 
+        // the remainder of prepareSample() once the motion from
+        // nearNode to newState is known to be valid: chooses the
+        // parent and the neighbors to rewire.
+        void prepareConnect(Planner& planner, Node *nearNode, Distance dNear, State& newState) {
             auto [isGoal, goalDist] = scenario_.goal()(scenario_.space(), newState);
             (void)goalDist; // mark unused (for now, may be used in approx solutions)
 
             Link* parent = nearNode->link(std::memory_order_relaxed);
             Distance parentCost = parent->cost() + dNear; // scenario_.space().distance(nearNode->state(), newState);
+            Distance parentDist = dNear;
 
             unsigned k = planner.rewireCount();
             // TODO: OMPL restricts rewiring considerations to
@@ -513,26 +849,60 @@ namespace unc::robotics::mpt::impl::prrt_star {
                 if (nbrLink->node() == nearNode || validMotion<false>(nbrLink->node()->state(), newState)) {
                     parent = nbrLink;
                     parentCost = newCost;
+                    parentDist = std::get<Distance>(nbh_[nbrIndex]);
                     break;
                 }
             }
 
+            pendingParent_ = parent->node();
+            pendingParentDist_ = parentDist;
+            pendingGoal_ = isGoal;
+
+            // when solving deterministically, the rewiring motions
+            // must be checked here, as commitSample() runs on one
+            // thread.  The check uses the costs at the time of
+            // preparing, and thus may check motions that will not
+            // rewire after earlier commits in the same round.
+            if constexpr (deterministic) {
+                for (auto& [nbrNode, nbrDist] : nbh_) {
+                    if (nbrNode == nullptr)
+                        continue;
+                    Link *nbrLink = nbrNode->link(std::memory_order_relaxed);
+                    if (!(parentCost + nbrDist < nbrLink->cost() &&
+                          validMotion<false>(newState, nbrNode->state())))
+                        nbrNode = nullptr;
+                }
+            }
+
+            pendingState_ = std::move(newState);
+        }
+
+        void commitSample(Planner& planner) {
+            if (pendingParent_ == nullptr)
+                return;
+
+            // the parent's link may have been replaced by a shorter
+            // one since the sample was prepared.
+            Link *parent = pendingParent_->link(std::memory_order_acquire);
+            Distance parentCost = parent->cost() + pendingParentDist_;
+            pendingParent_ = nullptr;
+
             Node* newNode;
             Link* newLink;
 
             if constexpr (concurrent) {
-                newNode = nodes_.allocate(isGoal, newState);
-                newLink = links_.allocate(newNode, parent, parentCost);
+                newNode = nodes_.allocate(pendingGoal_, std::move(*pendingState_));
+                newLink = allocateLink(newNode, parent, parentCost);
                 setLink(planner, newNode, newLink);
             } else {
-                newNode = nodes_.allocate(parent, parentCost, isGoal, newState);
+                newNode = nodes_.allocate(parent, parentCost, pendingGoal_, std::move(*pendingState_));
                 newLink = newNode->link();
             }
 
             planner.nn_.insert(newNode);
 
-            if (isGoal)
-                planner.foundGoal(newLink, goalDist);
+            if (pendingGoal_)
+                planner.foundGoal(newLink, Distance(0));
 
             // rewire from nearest to farthest (TODO: for PRRT, this
             // should be done in reverse)
@@ -546,9 +916,11 @@ namespace unc::robotics::mpt::impl::prrt_star {
 
                 Link *nbrLink = nbrNode->link(std::memory_order_acquire);
                 Distance newCost = parentCost + nbrDist;
-                if (newCost < nbrLink->cost() && validMotion<false>(newNode->state(), nbrNode->state())) {
+                if (newCost < nbrLink->cost() &&
+                    (deterministic || validMotion<false>(newNode->state(), nbrNode->state())))
+                {
                     if constexpr (concurrent) {
-                        setLink(planner, nbrNode, links_.allocate(nbrNode, newLink, newCost));
+                        setLink(planner, nbrNode, allocateLink(nbrNode, newLink, newCost));
                     } else {
                         // we special case the update for
                         // non-concurrent planning (i.e. standard
@@ -562,6 +934,36 @@ namespace unc::robotics::mpt::impl::prrt_star {
                     }
                 }
             }
+
+            if constexpr (memoryBudget != 0)
+                charge_.update(planner.budget_, memoryUsed());
+        }
+
+        // the bytes used by this worker's pools and its share of the
+        // nearest neighbor structure.  Retired links are counted
+        // since they remain allocated for reuse.
+        std::size_t memoryUsed() const {
+            return nodes_.bytes() + links_.bytes() + nodes_.size() * kNNBytesPerEntry;
+        }
+
+        // the links this worker retired and has not yet reused.  They
+        // may have been allocated by any worker.
+        std::size_t supersededLinks() const {
+            return linkLimbo_.retired() + linkLimbo_.available();
+        }
+
+        // "links" counts every link allocated by this worker,
+        // including those superseded (see PRRTStar::memoryStats()).
+        MemoryStats memoryStats() const {
+            MemoryStats stats;
+            stats.addPool("nodes", nodes_);
+            stats.addPool("links", links_);
+            stats.addVector("neighborhood", nbh_);
+            stats.addVector("neighborhood", linkIndices_);
+            stats.addVector("sample batch", batchNear_);
+            stats.addVector("sample batch", batchStates_);
+            stats.addVector("sample batch", batchFrom_);
+            return stats;
         }
 
         template <bool checkEnd>
@@ -600,8 +1002,12 @@ namespace unc::robotics::mpt::impl::prrt_star {
             }
         }
 
-        void setLink(Planner& planner, Node* node, Link* newLink) {
+        // sets node's link to newLink, unless node already has a
+        // shorter link.  Unless prune is false, the superseded link is
+        // then pruned from its parent's child list.
+        void setLink(Planner& planner, Node* node, Link* newLink, bool prune = true) {
             Link *oldLink = node->link(std::memory_order_relaxed);
+            unsigned retries = 0;
             for (;;) {
                 if (oldLink && oldLink->cost() <= newLink->cost()) {
                     // the existing link is shorter, move in reverse
@@ -613,14 +1019,16 @@ namespace unc::robotics::mpt::impl::prrt_star {
                         std::memory_order_release,
                         std::memory_order_relaxed))
                     break;
-                // MPT_LOG(DEBUG, "CAS failed (setLink)", no_);
+                ++retries;
             }
+            Stats::setLinkCAS() += retries;
 
             if (node->goal()) {
                 // note: prevSolution can be null under concurrency,
                 // the goal node is inserted into the motion graph
                 // before it updates the solution.
                 Link *prevSolution = planner.solution_.load(std::memory_order_acquire);
+                retries = 0;
                 while (prevSolution == nullptr || newLink->cost() < prevSolution->cost()) {
                     if (planner.solution_.compare_exchange_weak(
                             prevSolution, newLink,
@@ -635,10 +1043,10 @@ namespace unc::robotics::mpt::impl::prrt_star {
                                       << newLink->cost()
                                       << ", after " << planner.elapsedSolveTime();
                         break;
-                    } else {
-                        // MPT_LOG(DEBUG, "[%u]: CAS failed (update solution)", no_);
                     }
+                    ++retries;
                 }
+                Stats::solutionCAS() += retries;
             }
 
             // at this point, oldLink is "owned" by this thread,
@@ -646,6 +1054,19 @@ namespace unc::robotics::mpt::impl::prrt_star {
             if (oldLink == nullptr)
                 return;
 
+            // oldLink remains on the child list of its parent's link
+            // (unless it was moved there from a detached list, in
+            // which case the caller prunes).
+            if (prune)
+                pruneChildren(planner, oldLink->parentNode());
+
+            moveChildren(planner, node, oldLink, newLink);
+        }
+
+        // moves the children of node's superseded oldLink to its
+        // current newLink, reducing their costs to match.
+        void moveChildren(Planner& planner, Node *node, Link *oldLink, Link *newLink) {
+            unsigned retries;
             do {
                 Distance costDelta = oldLink->cost() - newLink->cost();
                 assert(costDelta >= 0);
@@ -653,19 +1074,32 @@ namespace unc::robotics::mpt::impl::prrt_star {
                 // remove the children from the oldLink.  Another thread
                 // may still have a reference to it.
                 Link *firstChild = oldLink->firstChild(std::memory_order_relaxed);
+                retries = 0;
                 while (!oldLink->casFirstChild(
                            firstChild, nullptr,
-                           std::memory_order_release,
-                           std::memory_order_relaxed)) {
-                    // MPT_LOG(DEBUG, "[%u]: CAS failed (firstChild)", no_);
-                }
+                           std::memory_order_acq_rel,
+                           std::memory_order_relaxed))
+                    ++retries;
+                Stats::detachCAS() += retries;
 
-                for (Link *oldChild = firstChild ; oldChild ; oldChild = oldChild->nextSibling(std::memory_order_acquire)) {
+                for (Link *oldChild = firstChild, *next ; oldChild ; oldChild = next) {
+                    next = oldChild->nextSibling(std::memory_order_relaxed);
                     Node *childNode = oldChild->node();
-                    Link *shorterLink = links_.allocate(childNode, newLink, oldChild->cost() - costDelta);
-                    setLink(planner, childNode, shorterLink);
+                    Link *shorterLink = allocateLink(
+                        childNode, newLink, oldChild->cost() - costDelta);
+                    setLink(planner, childNode, shorterLink, false);
+
+                    // oldChild is no longer on any child list, and
+                    // once superseded, no longer in the tree.
+                    if (childNode->link(std::memory_order_acquire) != oldChild)
+                        retireLink(planner, oldChild);
                 }
 
+                // the shorter links that lost to an existing link
+                // remain on newLink's child list.
+                if (firstChild)
+                    pruneChildren(planner, node);
+
                 // we've moved all the children from oldLink to
                 // newLink.  Check now that newLink is still active.
                 // If it is not, then we must move over any remaining
@@ -675,6 +1109,73 @@ namespace unc::robotics::mpt::impl::prrt_star {
                 newLink = node->link(std::memory_order_acquire);
             } while (oldLink != newLink);
         }
+
+        // removes the superseded links from the child list of node's
+        // current link, and retires them.  The list is detached,
+        // filtered, and the remaining children are pushed back.
+        void pruneChildren(Planner& planner, Node *node) {
+            if constexpr (concurrent) {
+                if (node == nullptr)
+                    return;
+
+                Link *link = node->link(std::memory_order_acquire);
+                Link *firstChild = link->firstChild(std::memory_order_relaxed);
+                unsigned retries = 0;
+                while (firstChild && !link->casFirstChild(
+                           firstChild, nullptr,
+                           std::memory_order_acq_rel,
+                           std::memory_order_relaxed))
+                    ++retries;
+                Stats::detachCAS() += retries;
+
+                for (Link *child = firstChild, *next ; child ; child = next) {
+                    next = child->nextSibling(std::memory_order_relaxed);
+                    if (child->node()->link(std::memory_order_acquire) == child) {
+                        link->pushChild(child, Stats::childPushCAS());
+                    } else {
+                        retireLink(planner, child);
+                    }
+                }
+
+                // if the link was superseded while its children were
+                // detached, the thread that superseded it may have
+                // missed the children pushed back.
+                Link *current = node->link(std::memory_order_acquire);
+                if (firstChild && current != link)
+                    moveChildren(planner, node, link, current);
+            }
+        }
+
+        Link* allocateLink(Node *node, Link *parent, Distance cost) {
+            if constexpr (concurrent) {
+                static_assert(std::is_trivially_destructible_v<Link>);
+                if (Link *link = linkLimbo_.reuse()) {
+                    Stats::reusedLink();
+                    return new (link) Link(node, parent, cost, Stats::childPushCAS());
+                }
+            }
+            return links_.allocate(node, parent, cost, Stats::childPushCAS());
+        }
+
+        // retires a link that is no longer in the tree, nor on any
+        // child list.  Goal links are not retired since the
+        // planner's solution may point to them.
+        void retireLink(Planner& planner, Link *link) {
+            if (!link->node()->goal()) {
+                linkLimbo_.retire(link, planner.epochs_.current());
+                Stats::retiredLink();
+            }
+        }
+
+        // makes the links retired in earlier epochs available for
+        // reuse, advancing the epoch when enough links are waiting.
+        void reclaimLinks(Planner& planner) {
+            if constexpr (concurrent) {
+                if (linkLimbo_.retired() >= kReclaimThreshold)
+                    planner.epochs_.tryAdvance();
+                linkLimbo_.reclaim(planner.epochs_.current());
+            }
+        }
     };
 }
 
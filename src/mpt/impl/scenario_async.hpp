@@ -0,0 +1,111 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_SCENARIO_ASYNC_HPP
+#define MPT_IMPL_SCENARIO_ASYNC_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <type_traits>
+
+namespace unc::robotics::mpt::impl {
+    // A scenario may optionally provide asynchronous versions of
+    // valid() and link():
+    //
+    //    Future validAsync(const State& q);
+    //    Future linkAsync(const State& a, const State& b);
+    //
+    // where Future is std::future<bool> or any type with the same
+    // wait(), wait_for(), and get() methods.  The scenario must copy
+    // the states it needs, as they are not guaranteed to outlive the
+    // call.  Planners that support it keep several samples in flight
+    // per worker while the results are computed, instead of blocking
+    // on each check.  A scenario with linkAsync must still provide
+    // the synchronous valid() and link() methods.
+    //
+    // When the planner's done function returns true, the checks still
+    // in flight are abandoned: their futures are destroyed without
+    // waiting on them.  A Future whose destructor blocks until its
+    // check completes (as one from std::async does) thus still delays
+    // the return from solve().
+
+    template <typename Scenario, typename State, class = void>
+    struct scenario_link_async : std::false_type {};
+
+    template <typename Scenario, typename State>
+    struct scenario_link_async<Scenario, State, std::void_t<decltype(
+        std::declval<Scenario&>().linkAsync(std::declval<const State&>(), std::declval<const State&>()))>>
+        : std::true_type
+    {
+        using type = decltype(std::declval<Scenario&>().linkAsync(
+                                  std::declval<const State&>(), std::declval<const State&>()));
+    };
+
+    template <typename Scenario, typename State>
+    constexpr bool scenario_has_link_async_v = scenario_link_async<Scenario, State>::value;
+
+    template <typename Scenario, typename State>
+    using scenario_link_async_t = typename scenario_link_async<Scenario, State>::type;
+
+    // when the scenario has no validAsync(), the type is nullptr_t as
+    // a placeholder for a result that is never used.
+    template <typename Scenario, typename State, class = void>
+    struct scenario_valid_async : std::false_type {
+        using type = std::nullptr_t;
+    };
+
+    template <typename Scenario, typename State>
+    struct scenario_valid_async<Scenario, State, std::void_t<decltype(
+        std::declval<Scenario&>().validAsync(std::declval<const State&>()))>>
+        : std::true_type
+    {
+        using type = decltype(std::declval<Scenario&>().validAsync(std::declval<const State&>()));
+    };
+
+    template <typename Scenario, typename State>
+    constexpr bool scenario_has_valid_async_v = scenario_valid_async<Scenario, State>::value;
+
+    template <typename Scenario, typename State>
+    using scenario_valid_async_t = typename scenario_valid_async<Scenario, State>::type;
+
+    template <typename Future>
+    bool asyncReady(const Future& f) {
+        return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+}
+
+#endif
@@ -0,0 +1,78 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_SCENARIO_SHARED_HPP
+#define MPT_IMPL_SCENARIO_SHARED_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace unc::robotics::mpt::impl {
+    // Each worker thread gets its own scenario.  By default, it is a
+    // copy of the scenario passed to the planner.  A scenario may
+    // instead separate the immutable data shared by all workers
+    // (e.g., meshes or a robot model) from the mutable scratch space
+    // each thread needs to check validity by providing:
+    //
+    //    SharedData shared() const;
+    //    Scenario(const SharedData&);
+    //
+    // where SharedData is cheap to copy (e.g., a std::shared_ptr to
+    // const data).  Workers then construct their scenario from
+    // shared() on the thread that will use it.
+
+    template <typename Scenario, class = void>
+    struct scenario_has_shared : std::false_type {};
+
+    template <typename Scenario>
+    struct scenario_has_shared<Scenario, std::void_t<decltype(std::declval<const Scenario&>().shared())>>
+        : std::is_constructible<Scenario, decltype(std::declval<const Scenario&>().shared())> {};
+
+    template <typename Scenario>
+    constexpr bool scenario_has_shared_v = scenario_has_shared<Scenario>::value;
+
+    // Creates the scenario for a worker from the planner's scenario.
+    template <typename Scenario>
+    Scenario workerScenario(const Scenario& scenario) {
+        if constexpr (scenario_has_shared_v<Scenario>) {
+            return Scenario(scenario.shared());
+        } else {
+            return scenario;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,108 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_SCENARIO_VALID_BATCH_HPP
+#define MPT_IMPL_SCENARIO_VALID_BATCH_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace unc::robotics::mpt::impl {
+    // A scenario may optionally check the validity of a batch of
+    // states in one call, e.g., to use a SIMD collision kernel:
+    //
+    //    void validBatch(const State* states, std::size_t n, bool* valid);
+    //
+    // which sets valid[i] to the result of valid(states[i]).
+
+    template <typename Scenario, typename State, class = void>
+    struct scenario_has_valid_batch : std::false_type {};
+
+    template <typename Scenario, typename State>
+    struct scenario_has_valid_batch<Scenario, State, std::void_t<decltype(
+        std::declval<Scenario&>().validBatch(
+            std::declval<const State*>(), std::declval<std::size_t>(), std::declval<bool*>()))>>
+        : std::true_type {};
+
+    template <typename Scenario, typename State>
+    constexpr bool scenario_has_valid_batch_v = scenario_has_valid_batch<Scenario, State>::value;
+
+    // Checks a batch of states with the scenario's validBatch()
+    // method when it has one, otherwise with valid() on each state.
+    template <typename Scenario, typename State>
+    void validBatch(Scenario& scenario, const State* states, std::size_t n, bool* valid) {
+        if constexpr (scenario_has_valid_batch_v<Scenario, State>) {
+            scenario.validBatch(states, n, valid);
+        } else {
+            for (std::size_t i=0 ; i<n ; ++i)
+                valid[i] = scenario.valid(states[i]);
+        }
+    }
+
+    // Likewise, a scenario may optionally check a batch of motions in
+    // one call:
+    //
+    //    void linkBatch(const State* from, const State* to, std::size_t n, bool* valid);
+    //
+    // which sets valid[i] to the result of link(from[i], to[i]).
+
+    template <typename Scenario, typename State, class = void>
+    struct scenario_has_link_batch : std::false_type {};
+
+    template <typename Scenario, typename State>
+    struct scenario_has_link_batch<Scenario, State, std::void_t<decltype(
+        std::declval<Scenario&>().linkBatch(
+            std::declval<const State*>(), std::declval<const State*>(),
+            std::declval<std::size_t>(), std::declval<bool*>()))>>
+        : std::true_type {};
+
+    template <typename Scenario, typename State>
+    constexpr bool scenario_has_link_batch_v = scenario_has_link_batch<Scenario, State>::value;
+
+    // Checks a batch of motions with the scenario's linkBatch()
+    // method when it has one, otherwise with link() on each motion.
+    template <typename Scenario, typename State>
+    void validMotionBatch(Scenario& scenario, const State* from, const State* to, std::size_t n, bool* valid) {
+        if constexpr (scenario_has_link_batch_v<Scenario, State>) {
+            scenario.linkBatch(from, to, n, valid);
+        } else {
+            for (std::size_t i=0 ; i<n ; ++i)
+                valid[i] = scenario.link(from[i], to[i]);
+        }
+    }
+}
+
+#endif
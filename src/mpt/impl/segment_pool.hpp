@@ -0,0 +1,90 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_SEGMENT_POOL_HPP
+#define MPT_IMPL_SEGMENT_POOL_HPP
+
+#include "../shared_segment.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace unc::robotics::mpt::impl {
+    // A SegmentPool has the same allocate() interface as an
+    // ObjectPool, but allocates its objects from a SharedSegment.
+    // Unlike an ObjectPool, the pool does not own the objects, they
+    // remain in the segment after the pool is destroyed.
+    template <typename T>
+    class SegmentPool {
+        SharedSegment *segment_;
+
+        // the number of objects this pool allocated
+        std::size_t size_{0};
+
+    public:
+        SegmentPool(const SegmentPool&) = delete;
+
+        explicit SegmentPool(SharedSegment *segment)
+            : segment_(segment)
+        {
+        }
+
+        SegmentPool(SegmentPool&& other)
+            : segment_(other.segment_)
+            , size_(std::exchange(other.size_, 0))
+        {
+        }
+
+        // the number of objects this pool allocated in the segment
+        std::size_t size() const {
+            return size_;
+        }
+
+        // the bytes of the objects this pool allocated, not counting
+        // the segment's alignment padding.
+        std::size_t bytes() const {
+            return size_ * sizeof(T);
+        }
+
+        template <typename ... Args>
+        T* allocate(Args&& ... args) {
+            T *p = segment_->template construct<T>(std::forward<Args>(args)...);
+            ++size_;
+            return p;
+        }
+    };
+}
+
+#endif
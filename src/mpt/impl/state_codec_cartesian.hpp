@@ -0,0 +1,96 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_STATE_CODEC_CARTESIAN_HPP
+#define MPT_IMPL_STATE_CODEC_CARTESIAN_HPP
+
+#include "../cartesian_space.hpp"
+#include <tuple>
+#include <utility>
+
+namespace unc::robotics::mpt::impl {
+    template <std::size_t I, typename T, typename M, typename Bounds>
+    using cartesian_state_codec_t = StateCodec<
+        Space<nigh::cartesian_state_element_t<I, T>,
+              std::tuple_element_t<I, M>>,
+        std::tuple_element_t<I, Bounds>>;
+
+    template <typename T, typename M, typename Bounds, typename Indices>
+    class CartesianStateCodec;
+
+    // Encodes each element of a cartesian state with its own codec.
+    template <typename T, typename M, typename Bounds, std::size_t ... I>
+    class CartesianStateCodec<T, M, Bounds, std::index_sequence<I...>>
+        : std::tuple<cartesian_state_codec_t<I, T, M, Bounds>...>
+    {
+        using Metric = nigh::metric::Space<T, M>;
+        using Base = std::tuple<cartesian_state_codec_t<I, T, M, Bounds>...>;
+
+        const Base& tuple() const { return *this; }
+
+    public:
+        using Type = T;
+        using Encoded = std::tuple<typename cartesian_state_codec_t<I, T, M, Bounds>::Encoded...>;
+
+        CartesianStateCodec(const Metric& space, const Bounds& bounds)
+            : Base(cartesian_state_codec_t<I, T, M, Bounds>(
+                       std::get<I>(space),
+                       std::get<I>(bounds))...)
+        {
+        }
+
+        Encoded encode(const Type& q) const {
+            return Encoded(std::get<I>(tuple()).encode(cartesian_state_element<I, T>::get(q))...);
+        }
+
+        Type decode(const Encoded& e) const {
+            Type q;
+            ((cartesian_state_element<I, T>::get(q) = std::get<I>(tuple()).decode(std::get<I>(e))), ...);
+            return q;
+        }
+    };
+}
+
+namespace unc::robotics::mpt {
+    template <typename T, typename ... M, typename Bounds>
+    struct StateCodec<Space<T, Cartesian<M...>>, Bounds>
+        : impl::CartesianStateCodec<T, Cartesian<M...>, Bounds, std::index_sequence_for<M...>>
+    {
+        using impl::CartesianStateCodec<T, Cartesian<M...>, Bounds, std::index_sequence_for<M...>>::CartesianStateCodec;
+    };
+}
+
+#endif
@@ -0,0 +1,93 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_STATE_CODEC_LP_HPP
+#define MPT_IMPL_STATE_CODEC_LP_HPP
+
+#include "../box_bounds.hpp"
+#include "../lp_space.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace unc::robotics::mpt {
+    // Encodes each coordinate as a 16-bit fixed-point value within
+    // the bounds.  Coordinates outside the bounds are clamped to
+    // them.
+    template <typename T, int p, typename S, int dim>
+    struct StateCodec<Space<T, LP<p>>, BoxBounds<S, dim>> {
+    private:
+        using Metric = Space<T, LP<p>>;
+        using Scalar = typename Metric::Distance;
+        static constexpr int kDimensions = Metric::kDimensions;
+        static_assert(kDimensions > 0, "state codec requires a fixed number of dimensions");
+
+        static constexpr std::uint16_t kMaxCode = 0xffff;
+
+        std::array<Scalar, kDimensions> min_;
+        std::array<Scalar, kDimensions> step_;
+
+    public:
+        using Type = T;
+        using Encoded = std::array<std::uint16_t, kDimensions>;
+
+        StateCodec(const Metric&, const BoxBounds<S, dim>& bounds) {
+            for (int i=0 ; i<kDimensions ; ++i) {
+                min_[i] = bounds.min()[i];
+                step_[i] = (bounds.max()[i] - bounds.min()[i]) / kMaxCode;
+            }
+        }
+
+        Encoded encode(const Type& q) const {
+            Encoded e;
+            for (int i=0 ; i<kDimensions ; ++i) {
+                Scalar t = step_[i] > 0 ? (Metric::coeff(q, i) - min_[i]) / step_[i] : Scalar(0);
+                e[i] = static_cast<std::uint16_t>(std::lround(std::clamp(t, Scalar(0), Scalar(kMaxCode))));
+            }
+            return e;
+        }
+
+        Type decode(const Encoded& e) const {
+            Type q;
+            for (int i=0 ; i<kDimensions ; ++i)
+                Metric::coeff(q, i) = min_[i] + e[i] * step_[i];
+            return q;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,108 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_IMPL_STATE_CODEC_SO3_HPP
+#define MPT_IMPL_STATE_CODEC_SO3_HPP
+
+#include "../so3_space.hpp"
+#include "../unbounded.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace unc::robotics::mpt {
+    // Encodes a unit quaternion with "smallest three" compression in
+    // 64 bits.  Since q and -q are the same rotation, the component
+    // with the largest magnitude is made positive and omitted, and
+    // the other three, which are within +/- sqrt(1/2), are stored as
+    // 20-bit fixed-point values, along with 2 bits for the index of
+    // the omitted component.  Decoding restores it from the unit norm.
+    template <typename T>
+    struct StateCodec<Space<T, SO3>, Unbounded> {
+    private:
+        using Metric = Space<T, SO3>;
+        using Scalar = typename Metric::Distance;
+
+        static constexpr unsigned kBits = 20;
+        static constexpr std::uint64_t kMaxCode = (std::uint64_t(1) << kBits) - 1;
+        static constexpr Scalar kRange = Scalar(0.707106781186547524400844362104849039L);
+
+    public:
+        using Type = T;
+        using Encoded = std::uint64_t;
+
+        StateCodec(const Metric&, Unbounded = Unbounded{}) {
+        }
+
+        Encoded encode(const Type& q) const {
+            int largest = 0;
+            for (int i=1 ; i<4 ; ++i)
+                if (std::abs(Metric::coeff(q, i)) > std::abs(Metric::coeff(q, largest)))
+                    largest = i;
+
+            Scalar sign = Metric::coeff(q, largest) < 0 ? Scalar(-1) : Scalar(1);
+            Encoded e = static_cast<Encoded>(largest);
+            unsigned shift = 2;
+            for (int i=0 ; i<4 ; ++i) {
+                if (i == largest)
+                    continue;
+                Scalar t = (sign * Metric::coeff(q, i) + kRange) / (2 * kRange) * kMaxCode;
+                e |= static_cast<Encoded>(std::llround(std::clamp(t, Scalar(0), Scalar(kMaxCode)))) << shift;
+                shift += kBits;
+            }
+            return e;
+        }
+
+        Type decode(const Encoded& e) const {
+            int largest = static_cast<int>(e & 3);
+            Type q;
+            Scalar sumSquares = 0;
+            unsigned shift = 2;
+            for (int i=0 ; i<4 ; ++i) {
+                if (i == largest)
+                    continue;
+                Scalar c = ((e >> shift) & kMaxCode) * (2 * kRange / kMaxCode) - kRange;
+                Metric::coeff(q, i) = c;
+                sumSquares += c * c;
+                shift += kBits;
+            }
+            Metric::coeff(q, largest) = std::sqrt(std::max(Scalar(0), Scalar(1) - sumSquares));
+            return q;
+        }
+    };
+}
+
+#endif
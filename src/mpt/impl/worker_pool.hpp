@@ -39,9 +39,12 @@
 
 #include "../log.hpp"
 #include "finally.hpp"
+#include <atomic>
+#include <exception>
+#include <memory>
 #include <omp.h>
-#include <vector>
 #include <stdexcept>
+#include <utility>
 
 namespace unc::robotics::mpt::impl {
 
@@ -49,12 +52,20 @@ namespace unc::robotics::mpt::impl {
     class WorkerPool {
         static_assert(maxThreads >= 0, "maxThreads must be non-negative");
 
-        std::vector<T, Allocator> workers_;
+        using AllocTraits = std::allocator_traits<Allocator>;
+
+        // the workers are constructed in place, in parallel, thus
+        // they are held in raw storage instead of a std::vector.
+        Allocator alloc_;
+        T *workers_{nullptr};
+        unsigned size_{0};
         std::atomic_bool solving_{false};
 
     public:
         WorkerPool(WorkerPool&& other)
-            : workers_(std::move(other.workers_))
+            : alloc_(std::move(other.alloc_))
+            , workers_(std::exchange(other.workers_, nullptr))
+            , size_(std::exchange(other.size_, 0))
         {
             assert(!other.solving_);
         }
@@ -62,6 +73,12 @@ namespace unc::robotics::mpt::impl {
         // this is not Args&& since we need to create multiple copies,
         // using std::forward<Args>(args)... could leave an argument
         // in a bad state.
+        //
+        // Each worker is constructed on the thread that will later
+        // run it, so that expensive per-worker setup (e.g., scenario
+        // copies) runs concurrently, and so that the worker's memory
+        // is first touched by its own thread.  Thus the arguments
+        // must be safe to read from multiple threads at once.
         template <typename ... Args>
         WorkerPool(const Args& ... args) {
             // Note: omp_get_num_procs() is the hardware concurrency
@@ -70,20 +87,62 @@ namespace unc::robotics::mpt::impl {
             // single-threaded)
 
             unsigned nThreads = std::max(1, omp_get_max_threads());
-            if (maxThreads != 0 && nThreads < (unsigned)maxThreads) {
+            if (maxThreads != 0 && nThreads > (unsigned)maxThreads) {
                 MPT_LOG(TRACE) << "limiting threads to " << maxThreads
                                << ", which is less than hardware concurrency ("
                                << nThreads << ")";
                 nThreads = maxThreads;
             }
 
-            workers_.reserve(nThreads);
-            for (unsigned no=0 ; no<nThreads ; ++no)
-                workers_.emplace_back(no, args...);
+            workers_ = AllocTraits::allocate(alloc_, nThreads);
+            size_ = nThreads;
+
+            if (nThreads == 1) {
+                try {
+                    AllocTraits::construct(alloc_, workers_, 0u, args...);
+                } catch (...) {
+                    AllocTraits::deallocate(alloc_, workers_, size_);
+                    throw;
+                }
+                return;
+            }
+
+            // exceptions cannot propagate out of the parallel region,
+            // so the first one is saved and rethrown after the
+            // successfully constructed workers are destroyed.
+            std::unique_ptr<bool[]> constructed(new bool[nThreads]());
+            std::exception_ptr error;
+#pragma omp parallel for schedule(static, 1) num_threads(nThreads)
+            for (unsigned no = 0 ; no < nThreads ; ++no) {
+                try {
+                    AllocTraits::construct(alloc_, workers_ + no, no, args...);
+                    constructed[no] = true;
+                } catch (...) {
+#pragma omp critical
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+
+            if (error) {
+                for (unsigned i = nThreads ; i-- > 0 ; )
+                    if (constructed[i])
+                        AllocTraits::destroy(alloc_, workers_ + i);
+                AllocTraits::deallocate(alloc_, workers_, size_);
+                std::rethrow_exception(error);
+            }
+        }
+
+        ~WorkerPool() {
+            if (workers_) {
+                for (unsigned i = size_ ; i-- > 0 ; )
+                    AllocTraits::destroy(alloc_, workers_ + i);
+                AllocTraits::deallocate(alloc_, workers_, size_);
+            }
         }
 
         unsigned size() const {
-            return static_cast<unsigned>(workers_.size());
+            return size_;
         }
 
         T& operator[] (std::size_t i) {
@@ -124,6 +183,55 @@ namespace unc::robotics::mpt::impl {
             }
         }
 
+        // Runs the workers in lock-step rounds.  In each round, the
+        // workers first call prepare(context) concurrently, and then
+        // the master thread calls commit(context) on each worker in
+        // order and checks doneFn.  Since commits do not overlap
+        // with prepares, each prepare sees the same snapshot of the
+        // context regardless of thread scheduling.
+        template <typename Context, typename DoneFn>
+        void solveRounds(Context& context, DoneFn doneFn) {
+            if (solving_.exchange(true))
+                throw std::runtime_error("already solving");
+            auto unsolving = finally([&]() { solving_ = false; });
+
+            unsigned nWorkers = size();
+            MPT_LOG(INFO) << "solving in rounds with " << nWorkers << " workers";
+
+            bool done = doneFn();
+            std::atomic_bool failed{false};
+#pragma omp parallel shared(done, failed) num_threads(nWorkers)
+            {
+                unsigned nThreads = omp_get_num_threads();
+                unsigned tNo = omp_get_thread_num();
+                while (!done) {
+                    // OpenMP may give us fewer threads than workers,
+                    // in which case threads prepare multiple workers.
+                    try {
+                        for (unsigned i = tNo ; i < nWorkers ; i += nThreads)
+                            workers_[i].prepare(context);
+                    } catch (const std::exception& ex) {
+                        MPT_LOG(ERROR) << "prepare died with exception: " << ex.what();
+                        failed = true;
+                    }
+#pragma omp barrier
+#pragma omp master
+                    {
+                        try {
+                            if (!failed)
+                                for (unsigned i = 0 ; i < nWorkers ; ++i)
+                                    workers_[i].commit(context);
+                            done = failed || doneFn();
+                        } catch (const std::exception& ex) {
+                            MPT_LOG(ERROR) << "commit died with exception: " << ex.what();
+                            done = true;
+                        }
+                    }
+#pragma omp barrier
+                }
+            }
+        }
+
         // T& operator() {
         //     return workers_[omp_get_thread_num()];
         // }
@@ -138,7 +246,7 @@ namespace unc::robotics::mpt::impl {
         T worker_;
     public:
         WorkerPool(WorkerPool&& other)
-            : worker_(std::move(other))
+            : worker_(std::move(other.worker_))
         {
         }
 
@@ -168,6 +276,15 @@ namespace unc::robotics::mpt::impl {
             MPT_LOG(INFO) << "solving with 1 thread";
             worker_.solve(context, doneFn);
         }
+
+        template <typename Context, typename DoneFn>
+        void solveRounds(Context& context, DoneFn doneFn) {
+            MPT_LOG(INFO) << "solving in rounds with 1 worker";
+            while (!doneFn()) {
+                worker_.prepare(context);
+                worker_.commit(context);
+            }
+        }
     };
 
 }
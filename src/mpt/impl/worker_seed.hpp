@@ -33,66 +33,57 @@
 
 //! @author Jeff Ichnowski
 
-#ifndef MPT_DEMO_PROC_INFO_HPP
-#define MPT_DEMO_PROC_INFO_HPP
+#pragma once
+#ifndef MPT_IMPL_WORKER_SEED_HPP
+#define MPT_IMPL_WORKER_SEED_HPP
 
-#include <sys/types.h>
-#include <unistd.h>
-#include <fstream>
+#include <cstdint>
 #include <iterator>
+#include <random>
+#include <vector>
 
-#ifdef linux
-#include <malloc.h>
-#endif
-
-namespace mpt_demo {
-    class ProcInfo {
-    public:
-	template <typename Char, typename Traits>
-	friend decltype(auto) operator<<(
-	    std::basic_ostream<Char,Traits>& out, const ProcInfo& p)
-	{
-
-            // TODO: need to find OSX equivalent
-#ifdef linux
-            struct mallinfo mi = mallinfo();
+namespace unc::robotics::mpt::impl {
 
-            // std::cout << std::flush;
-            // std::cerr << "==== malloc_stats ===== " << std::endl;
-            // malloc_stats();
-            // std::cerr << "==== malloc_stats end =====" << std::endl;
+    // WorkerSeed derives a per-worker seed sequence from a seed
+    // sequence shared by all workers, by mixing the worker number
+    // into the shared seed data.  When the shared seed is
+    // deterministic (e.g., FixedSeed), each worker gets a distinct
+    // but reproducible random number stream.
+    template <typename Seed>
+    class WorkerSeed {
+        const Seed& seed_;
+        unsigned no_;
 
-            out <<
-                // arena is also called "system bytes"
-                // and is equivalent to mi.uordblks + mi.fordblks
-                "Non-mmapped space allocated (bytes): " << mi.arena << "\n"
-                "Space allocated in mmapped regions (bytes): " << mi.hblkhd << "\n"
-                "Maximum total allocated space (bytes): " << mi.usmblks << "\n"
-                "Total allocated space (bytes): " << mi.uordblks << "\n"
-                "Total free space (bytes): " << mi.fordblks << "\n"
-                "Top-most, releasable space (bytes): " << mi.keepcost << "\n";
-#endif
+    public:
+        using result_type = std::uint32_t;
 
-#if 0
-            pid_t pid_{getpid()};
-	    std::string fileName =
-		"/proc/" + std::to_string(pid_) + "/status";
-	
-	    std::ifstream fin(fileName);
+        WorkerSeed(const Seed& seed, unsigned no)
+            : seed_(seed)
+            , no_(no)
+        {
+        }
 
-	    if (!fin)
-		throw std::runtime_error("failed to open: "+fileName);
+        template <class RandomIt>
+        void generate(RandomIt begin, RandomIt end) const {
+            std::vector<result_type> data(std::distance(begin, end) + 1);
+            seed_.generate(data.begin(), data.end() - 1);
+            data.back() = no_;
+            std::seed_seq seq(data.begin(), data.end());
+            seq.generate(begin, end);
+        }
 
-	    fin.unsetf(std::ios_base::skipws);
-	
-	    std::copy(
-		std::istreambuf_iterator<char>(fin),
-		std::istreambuf_iterator<char>(),
-		std::ostream_iterator<Char>(out));
-#endif	
-	    return out;
-	}
+        std::size_t size() const {
+            return seed_.size() + 1;
+        }
     };
+
+    // Creates a random number generator for a worker, seeded with a
+    // WorkerSeed.
+    template <typename RNG, typename Seed>
+    RNG workerRNG(const Seed& seed, unsigned no) {
+        const WorkerSeed<Seed> workerSeed(seed, no);
+        return RNG(workerSeed);
+    }
 }
 
 #endif
@@ -0,0 +1,282 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_PLANNER_EXECUTOR_HPP
+#define MPT_PLANNER_EXECUTOR_HPP
+
+#include "log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace unc::robotics::mpt {
+
+    // A PlannerExecutor runs many independent planner instances on
+    // a single fixed set of threads.  This is intended for services
+    // that receive bursts of small queries, where giving each query
+    // its own team of hardware_concurrency threads would
+    // oversubscribe the machine, and running each query
+    // single-threaded leaves cores idle between bursts.
+    //
+    // Submitted planners are scheduled earliest-deadline-first.  A
+    // planner runs on one executor thread at a time, and should thus
+    // be created with the single_threaded tag.  Time slices are
+    // measured in planner iterations: every sliceIterations calls to
+    // the done predicate, the running planner checks if its deadline
+    // has passed or if a queued planner has an earlier deadline, and
+    // in the latter case yields its thread back to the scheduler.
+    // Since a yield returns from the planner's solve() method, the
+    // planner resumes from where it left off the next time it is
+    // scheduled.
+    //
+    // The submitted planner must remain valid until the future
+    // returned by submit() is ready.  The destructor waits for all
+    // submitted planners to complete.
+    class PlannerExecutor {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+    private:
+        using Rep = Clock::rep;
+
+        struct Task {
+            TimePoint deadline_;
+            std::promise<void> promise_;
+
+            explicit Task(const TimePoint& deadline)
+                : deadline_(deadline)
+            {
+            }
+
+            virtual ~Task() {}
+
+            // Runs the task until it completes or it should yield
+            // to a task with an earlier deadline.  Returns true if
+            // the task completed (and its promise is set).
+            virtual bool run(PlannerExecutor& executor) = 0;
+        };
+
+        template <typename Planner, typename DoneFn>
+        struct PlannerTask : Task {
+            Planner& planner_;
+            DoneFn doneFn_;
+
+            PlannerTask(Planner& planner, const TimePoint& deadline, DoneFn&& doneFn)
+                : Task(deadline)
+                , planner_(planner)
+                , doneFn_(std::move(doneFn))
+            {
+            }
+
+            bool run(PlannerExecutor& executor) override {
+                bool complete = false;
+                try {
+                    if (Clock::now() >= this->deadline_) {
+                        complete = true;
+                    } else {
+                        unsigned count = 0;
+                        planner_.solve([&] {
+                            if (doneFn_())
+                                return complete = true;
+                            if (++count < executor.sliceIterations_)
+                                return false;
+                            count = 0;
+                            if (Clock::now() >= this->deadline_)
+                                return complete = true;
+                            return executor.shouldYield(this->deadline_);
+                        });
+                    }
+                } catch (...) {
+                    this->promise_.set_exception(std::current_exception());
+                    return true;
+                }
+
+                if (complete)
+                    this->promise_.set_value();
+                return complete;
+            }
+        };
+
+        unsigned sliceIterations_;
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_{false};
+
+        // min-heap of queued tasks, ordered by deadline.
+        std::vector<std::unique_ptr<Task>> queue_;
+
+        // the deadline of the task at the top of the heap, or the
+        // maximum representable time when the queue is empty.
+        // Running tasks check this without locking the mutex to
+        // decide whether or not they should yield.
+        alignas(64) std::atomic<Rep> earliestQueued_{std::numeric_limits<Rep>::max()};
+
+        std::vector<std::thread> threads_;
+
+        static bool laterDeadline(const std::unique_ptr<Task>& a, const std::unique_ptr<Task>& b) {
+            return a->deadline_ > b->deadline_;
+        }
+
+        // must be called with the mutex locked
+        void updateEarliest() {
+            earliestQueued_.store(
+                queue_.empty()
+                ? std::numeric_limits<Rep>::max()
+                : queue_.front()->deadline_.time_since_epoch().count(),
+                std::memory_order_relaxed);
+        }
+
+        // must be called with the mutex locked
+        void push(std::unique_ptr<Task>&& task) {
+            queue_.push_back(std::move(task));
+            std::push_heap(queue_.begin(), queue_.end(), laterDeadline);
+            updateEarliest();
+        }
+
+        // must be called with the mutex locked
+        std::unique_ptr<Task> pop() {
+            std::pop_heap(queue_.begin(), queue_.end(), laterDeadline);
+            std::unique_ptr<Task> task = std::move(queue_.back());
+            queue_.pop_back();
+            updateEarliest();
+            return task;
+        }
+
+        bool shouldYield(const TimePoint& deadline) const {
+            return earliestQueued_.load(std::memory_order_relaxed) < deadline.time_since_epoch().count();
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (;;) {
+                cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty())
+                    return;
+
+                std::unique_ptr<Task> task = pop();
+                lock.unlock();
+                bool complete = task->run(*this);
+                lock.lock();
+
+                if (!complete)
+                    push(std::move(task));
+            }
+        }
+
+    public:
+        PlannerExecutor(const PlannerExecutor&) = delete;
+        PlannerExecutor& operator = (const PlannerExecutor&) = delete;
+
+        explicit PlannerExecutor(
+            unsigned nThreads = std::thread::hardware_concurrency(),
+            unsigned sliceIterations = 64)
+            : sliceIterations_(std::max(1u, sliceIterations))
+        {
+            nThreads = std::max(1u, nThreads);
+            MPT_LOG(DEBUG) << "starting executor with " << nThreads << " threads, "
+                           << sliceIterations_ << " iterations per slice";
+            threads_.reserve(nThreads);
+            for (unsigned i=0 ; i<nThreads ; ++i)
+                threads_.emplace_back(&PlannerExecutor::run, this);
+        }
+
+        ~PlannerExecutor() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            for (std::thread& thread : threads_)
+                thread.join();
+        }
+
+        unsigned size() const {
+            return static_cast<unsigned>(threads_.size());
+        }
+
+        unsigned sliceIterations() const {
+            return sliceIterations_;
+        }
+
+        // Schedules the planner to run until the deadline is reached
+        // or the doneFn predicate returns true.  The returned future
+        // becomes ready when the planner is done, and will rethrow
+        // any exception that the planner's solve() threw.
+        template <typename Planner, typename DoneFn>
+        std::future<void> submit(Planner& planner, const TimePoint& deadline, DoneFn doneFn) {
+            auto task = std::make_unique<PlannerTask<Planner, DoneFn>>(
+                planner, deadline, std::move(doneFn));
+            std::future<void> future = task->promise_.get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                push(std::move(task));
+            }
+            cv_.notify_one();
+            return future;
+        }
+
+        template <typename Planner>
+        std::future<void> submit(Planner& planner, const TimePoint& deadline) {
+            return submit(planner, deadline, [] { return false; });
+        }
+
+        template <typename Planner, typename DoneFn, typename Rep_, typename Period>
+        std::future<void> submitFor(
+            Planner& planner, const std::chrono::duration<Rep_, Period>& duration, DoneFn doneFn)
+        {
+            return submit(
+                planner,
+                Clock::now() + std::chrono::duration_cast<Clock::duration>(duration),
+                std::move(doneFn));
+        }
+
+        template <typename Planner, typename Rep_, typename Period>
+        std::future<void> submitFor(Planner& planner, const std::chrono::duration<Rep_, Period>& duration) {
+            return submitFor(planner, duration, [] { return false; });
+        }
+    };
+}
+
+#endif
@@ -37,6 +37,7 @@
 #ifndef MPT_PLANNER_TAGS_HPP
 #define MPT_PLANNER_TAGS_HPP
 
+#include <cstddef>
 #include <type_traits>
 
 namespace unc::robotics::mpt {
@@ -46,6 +47,13 @@ namespace unc::robotics::mpt {
     struct rewire_k_nearest {};
     struct rewire_r_nearest {};
 
+    // Caps the number of worker threads at threadCount.  The planner
+    // uses min(threadCount, omp_get_max_threads()) threads, thus
+    // OMP_NUM_THREADS can lower the count but not raise it above the
+    // cap.  0 (hardware_concurrency) means no cap.  With
+    // deterministic, the number of threads determines the result,
+    // thus set both the cap and OMP_NUM_THREADS (or run on machines
+    // with at least threadCount cores) to reproduce a result.
     template <int threadCount>
     struct max_threads {
         // note: we're leaving threadCount as a signed integer since
@@ -55,6 +63,132 @@ namespace unc::robotics::mpt {
     };
     using single_threaded = max_threads<1>;
     using hardware_concurrency = max_threads<0>;
+
+    // Buffers up to batchSize new nodes in each worker before
+    // publishing them to the shared nearest neighbor structure.  A
+    // worker searches its own unpublished nodes along with the shared
+    // structure, but other workers will not see them until they are
+    // published.  Larger batches reduce contention on concurrent
+    // inserts at the cost of slightly stale nearest neighbor results.
+    // The default of 1 inserts every node immediately.
+    template <int batchSize>
+    struct insert_batch {
+        static_assert(batchSize > 0, "insert batch size must be positive");
+    };
+
+    // Processes samples in batches of batchSize in each worker.  The
+    // worker draws the batch of samples and finds their nearest
+    // neighbors, then checks the validity of the batch's states
+    // together (with the scenario's validBatch() method if it has
+    // one), then checks the motions together (with linkBatch()), and
+    // adds the valid samples to the graph.  This keeps the
+    // instruction cache on one kind of work at a time, and allows a
+    // scenario to check states and motions with SIMD (see
+    // impl/scenario_valid_batch.hpp).  With PPRM, the samples in a
+    // batch do not connect to each other.  The default of 1
+    // processes one sample at a time.
+    // Ignored when solving deterministically or asynchronously.
+    template <int batchSize>
+    struct sample_batch {
+        static_assert(batchSize > 0, "sample batch size must be positive");
+    };
+
+    // The number of samples each worker keeps in flight when the
+    // scenario provides asynchronous motion checks (see
+    // impl/scenario_async.hpp).  Ignored for scenarios without
+    // linkAsync().  Currently only supported by PRRT.
+    template <int depth>
+    struct async_depth {
+        static_assert(depth > 0, "async depth must be positive");
+    };
+
+    // Makes planning reproducible for a given seed.  Each worker's
+    // random number generator is seeded from the planner's seed
+    // (FixedSeed by default) combined with the worker's number, and
+    // the workers run in lock-step rounds: all workers prepare a
+    // sample against the same snapshot of the graph concurrently,
+    // then the samples are added to the graph in worker order.  The
+    // result depends on the number of workers, thus combine with
+    // max_threads<N> to reproduce results across machines.  Rounds
+    // wait on the slowest worker, thus this is slower than the
+    // default.  Not supported with pipeline.
+    struct deterministic {};
+
+    // Builds the roadmap in a SharedSegment (see shared_segment.hpp)
+    // so that multiple processes on the same host may build and query
+    // one roadmap concurrently.  The planner must be constructed with
+    // the segment.  Currently only supported by PPRM.
+    struct shared_roadmap {};
+
+    // Stores the states of the roadmap compressed with the
+    // StateCodec of the scenario's space and bounds (see
+    // state_codec.hpp), e.g., 16-bit fixed point coordinates within
+    // box bounds and 64-bit rotations.  Samples are replaced by their
+    // decoded states before they are checked, thus the roadmap's
+    // motions are valid for the states stored.  Start and goal
+    // states are kept exactly, and their motions are checked from
+    // the exact states.  With shared_roadmap, every process must use
+    // the same bounds.  Currently only supported by PPRM.
+    struct quantized_states {};
+
+    // Allocates the planner's nodes (and edges or links) from arenas
+    // of blockSize bytes instead of one allocation per object.  Each
+    // worker owns its arenas, and objects are packed contiguously in
+    // cache-line friendly slots, which reduces allocator overhead and
+    // TLB misses on large graphs.  When hugePages is true, the arenas
+    // are backed by huge pages (Linux only), in which case blockSize
+    // must be a multiple of 2 MiB.  Ignored by PPRM with
+    // shared_roadmap and by PRRT with pipeline.
+    template <std::size_t blockSize = (std::size_t(2) << 20), bool hugePages = false>
+    struct arena_pool {
+        static_assert(blockSize > 0, "arena block size must be positive");
+    };
+
+    // Stores the links of the planner's graph (PRRT parents, PRRT*
+    // parent/child/sibling links, and PPRM edge targets and lists)
+    // as 32-bit indices instead of pointers.  Nodes, links, and edges
+    // are then allocated from per-worker blocks of a virtual address
+    // region reserved once per process (up to 32 GiB), which shrinks
+    // the graph and makes its atomic updates 32-bit.  Replaces
+    // arena_pool, and ignores allocator for the graph's objects.
+    // Ignored by PPRM with shared_roadmap and by PRRT with pipeline.
+    struct compact_graph {};
+
+    // Allocates the planner's pools, internal containers, and
+    // nearest neighbor structure with the allocator A, rebound to
+    // each type they allocate.  The allocators are default
+    // constructed, thus A is typically stateless or refers to a
+    // global or thread-local resource (e.g. a jemalloc arena, or a
+    // monotonic arena for the current query).  Ignored by PRRT with
+    // pipeline.
+    template <typename A>
+    struct allocator {
+        using type = A;
+    };
+
+    // Limits the memory of the planner's graph to about bytes.  The
+    // planner tracks the bytes allocated by its pools (nodes, links,
+    // edges, and goals, along with an estimate for the nearest
+    // neighbor structure), and solve() returns once they near the
+    // budget, even if the done predicate has not returned true.
+    // Since pools grow a block at a time, the budget may be exceeded
+    // by about one block per worker.  memoryBudgetReached() reports
+    // whether the budget stopped the last solve().  Ignored by PRRT
+    // with pipeline, and by PPRM with shared_roadmap.
+    template <std::size_t bytes>
+    struct memory_budget : std::integral_constant<std::size_t, bytes> {
+        static_assert(bytes > 0, "memory budget must be positive");
+    };
+
+    // Runs the planner as a pipeline of stages, in which each stage
+    // has its own fixed number of threads.  The total number of
+    // threads is the sum of the stage thread counts, and max_threads
+    // is ignored.  Currently only supported by PRRT.
+    template <int sampleThreads, int nearestThreads, int validateThreads, int insertThreads>
+    struct pipeline {
+        static_assert(sampleThreads > 0 && nearestThreads > 0 && validateThreads > 0 && insertThreads > 0,
+                      "every pipeline stage requires at least one thread");
+    };
 }
 
 #endif
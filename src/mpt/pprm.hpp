@@ -42,13 +42,16 @@
 #include "impl/packs.hpp"
 #include "impl/pack_nearest.hpp"
 #include "impl/nearest_strategy.hpp"
+#include "impl/pool_strategy.hpp"
 #include "impl/pprm/pprm.hpp"
 
 namespace unc::robotics::mpt {
 
     namespace impl {
         // this is the actual strategy type for a PPRM planner
-        template <int maxThreads, bool reportStats, typename NNStrategy>
+        template <int maxThreads, bool reportStats, typename NNStrategy, bool deterministic, bool shared,
+                  int sampleBatch, bool quantized, typename PoolStrategy, typename Allocator,
+                  std::size_t memoryBudget>
         struct PPRMStrategy {};
 
         // Option parser to generate a PPRMStrategy from a
@@ -57,16 +60,32 @@ namespace unc::robotics::mpt {
         struct PPRMOptions {
             static constexpr bool reportStats = pack_bool_tag_v<report_stats, false, Options...>;
             static constexpr int maxThreads = pack_int_tag_v<max_threads, 0, Options...>;
+            static constexpr bool deterministic = pack_contains_v<mpt::deterministic, Options...>;
+            static constexpr bool shared = pack_contains_v<shared_roadmap, Options...>;
+            static constexpr int sampleBatch = pack_int_tag_v<sample_batch, 1, Options...>;
+            static constexpr bool quantized = pack_contains_v<quantized_states, Options...>;
+            static constexpr std::size_t memoryBudget = pack_value_tag<
+                std::size_t, memory_budget, 0, Options...>::value;
 
             using NNStrategy = pack_nearest_t<Options...>;
-            using type = PPRMStrategy<maxThreads, reportStats, NNStrategy>;
+            using PoolStrategy = pack_find_t<is_pool_strategy, void, Options...>;
+            using Allocator = pack_allocator_t<Options...>;
+            using type = PPRMStrategy<
+                maxThreads, reportStats, NNStrategy, deterministic, shared, sampleBatch, quantized,
+                PoolStrategy, Allocator, memoryBudget>;
         };
 
-        template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy>
-        struct PlannerResolver<Scenario, impl::PPRMStrategy<maxThreads, reportStats, NNStrategy>> {
+        template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy, bool deterministic,
+                  bool shared, int sampleBatch, bool quantized, typename PoolStrategy, typename Allocator,
+                  std::size_t memoryBudget>
+        struct PlannerResolver<Scenario, impl::PPRMStrategy<
+            maxThreads, reportStats, NNStrategy, deterministic, shared, sampleBatch, quantized,
+            PoolStrategy, Allocator, memoryBudget>>
+        {
             using type = impl::pprm::PPRM<
                 Scenario, maxThreads, reportStats,
-                nearest_strategy_t<Scenario, maxThreads, NNStrategy>>;
+                nearest_strategy_t<Scenario, maxThreads, NNStrategy>,
+                deterministic, shared, sampleBatch, quantized, PoolStrategy, Allocator, memoryBudget>;
         };
     }
 
@@ -77,6 +96,32 @@ namespace unc::robotics::mpt {
     //    - nigh::KDTreeBatch<...> - fastest, supports concurrent operation, but does not support arbitrary metrics
     //    - nigh::Linear - slowest, supports concurrent operations, supports arbitrary metrics
     //    - nigh::GNAT<...> - fast, does NOT support concurrent operations, supports metrics for which triangle property holds
+    // - batched sample processing
+    //    - tag::sample_batch<B> - each worker processes B samples at
+    //      a time.
+    // - reproducible planning
+    //    - tag::deterministic - the same seed and number of threads
+    //      produces the same result, at some cost in throughput.
+    // - multi-process roadmaps
+    //    - tag::shared_roadmap - nodes and edges are allocated in a
+    //      SharedSegment passed to the constructor.
+    // - compressed roadmaps
+    //    - tag::quantized_states - stores states compressed with
+    //      the StateCodec for the scenario's space and bounds.
+    // - node allocation
+    //    - tag::arena_pool<B,H> - allocates nodes and edges from
+    //      B-byte arenas, backed by huge pages when H is true.
+    //      Ignored with shared_roadmap.
+    //    - tag::compact_graph - links nodes and edges with 32-bit
+    //      indices into a process-wide region instead of pointers.
+    //      Ignored with shared_roadmap.
+    //    - tag::allocator<A> - allocates pools and internal
+    //      containers with the allocator A.  Nodes and edges are
+    //      still allocated from the segment with shared_roadmap.
+    // - memory limits
+    //    - tag::memory_budget<N> - solve() returns before the
+    //      planner's pools exceed about N bytes.  Ignored with
+    //      shared_roadmap, which is bounded by its segment.
     template <typename ... Options>
     using PPRM = typename impl::PPRMOptions<Options...>::type;
 }
@@ -42,32 +42,86 @@
 #include "impl/packs.hpp"
 #include "impl/pack_nearest.hpp"
 #include "impl/nearest_strategy.hpp"
+#include "impl/pool_strategy.hpp"
 #include "impl/prrt/prrt.hpp"
+#include "impl/prrt/pipeline.hpp"
 
 namespace unc::robotics::mpt {
 
     namespace impl {
-        // this is the actual strategy type for a PRRT planner
-        template <int maxThreads, bool reportStats, typename NNStrategy>
+        // this is the actual strategy type for a PRRT planner.
+        // Pipeline is void when not running as a pipeline.
+        template <int maxThreads, bool reportStats, typename NNStrategy, int insertBatch,
+                  bool deterministic, int asyncDepth, int sampleBatch, typename Pipeline,
+                  typename PoolStrategy, typename Allocator, std::size_t memoryBudget>
         struct PRRTStrategy {};
 
+        template <typename T>
+        struct is_pipeline : std::false_type {};
+
+        template <int s, int n, int v, int i>
+        struct is_pipeline<pipeline<s, n, v, i>> : std::true_type {};
+
         // Option parser to generate a PRRTStrategy from a
         // collection of unordered options.
         template <typename ... Options>
         struct PRRTOptions {
             static constexpr int maxThreads = pack_int_tag_v<max_threads, 0, Options...>;
             static constexpr bool reportStats = pack_bool_tag_v<report_stats, false, Options...>;
+            static constexpr int insertBatch = pack_int_tag_v<insert_batch, 1, Options...>;
+            static constexpr bool deterministic = pack_contains_v<mpt::deterministic, Options...>;
+            static constexpr int asyncDepth = pack_int_tag_v<async_depth, 4, Options...>;
+            static constexpr int sampleBatch = pack_int_tag_v<sample_batch, 1, Options...>;
+            static constexpr std::size_t memoryBudget = pack_value_tag<
+                std::size_t, memory_budget, 0, Options...>::value;
 
             using NNStrategy = pack_nearest_t<Options...>;
 
-            using type = PRRTStrategy<maxThreads, reportStats, NNStrategy>;
+            using Pipeline = pack_find_t<is_pipeline, void, Options...>;
+            using PoolStrategy = pack_find_t<is_pool_strategy, void, Options...>;
+            using Allocator = pack_allocator_t<Options...>;
+
+            static_assert(!deterministic || std::is_void_v<Pipeline>,
+                          "PRRT does not support deterministic with pipeline");
+
+            using type = PRRTStrategy<
+                maxThreads, reportStats, NNStrategy, insertBatch, deterministic, asyncDepth, sampleBatch, Pipeline,
+                PoolStrategy, Allocator, memoryBudget>;
         };
 
-        template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy>
-        struct PlannerResolver<Scenario, impl::PRRTStrategy<maxThreads, reportStats, NNStrategy>> {
+        template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy, int insertBatch,
+                  bool deterministic, int asyncDepth, int sampleBatch, typename PoolStrategy, typename Allocator,
+                  std::size_t memoryBudget>
+        struct PlannerResolver<Scenario, impl::PRRTStrategy<
+            maxThreads, reportStats, NNStrategy, insertBatch, deterministic, asyncDepth, sampleBatch, void,
+            PoolStrategy, Allocator, memoryBudget>>
+        {
             using type = impl::prrt::PRRT<
                 Scenario, maxThreads, reportStats,
-                nearest_strategy_t<Scenario, maxThreads, NNStrategy>>;
+                nearest_strategy_t<Scenario, maxThreads, NNStrategy>,
+                insertBatch, deterministic, asyncDepth, sampleBatch, PoolStrategy, Allocator, memoryBudget>;
+        };
+
+        // the pipeline's insert stage does not (currently) batch
+        // its inserts, thus insertBatch is ignored.  Its validate
+        // stage is synchronous and one sample at a time, thus
+        // asyncDepth and sampleBatch are also ignored, as are the
+        // pool strategy, allocator, and memory budget.
+        template <typename Scenario, int maxThreads, bool reportStats, typename NNStrategy, int insertBatch,
+                  int asyncDepth, int sampleBatch, typename PoolStrategy, typename Allocator,
+                  std::size_t memoryBudget,
+                  int sampleThreads, int nearestThreads, int validateThreads, int insertThreads>
+        struct PlannerResolver<Scenario, impl::PRRTStrategy<
+            maxThreads, reportStats, NNStrategy, insertBatch, false, asyncDepth, sampleBatch,
+            pipeline<sampleThreads, nearestThreads, validateThreads, insertThreads>, PoolStrategy, Allocator,
+            memoryBudget>>
+        {
+            // the stages always run concurrently, thus the nearest
+            // neighbor strategy is selected as if for unlimited
+            // threads.
+            using type = impl::prrt::PRRTPipeline<
+                Scenario, sampleThreads, nearestThreads, validateThreads, insertThreads,
+                reportStats, nearest_strategy_t<Scenario, 0, NNStrategy>>;
         };
     }
 
@@ -78,6 +132,33 @@ namespace unc::robotics::mpt {
     //    - nigh::KDTreeBatch<...> - fastest, supports concurrent operation, but does not support arbitrary metrics
     //    - nigh::Linear - slowest, supports concurrent operations, supports arbitrary metrics
     //    - nigh::GNAT<...> - fast, does NOT support concurrent operations, supports metrics for which triangle property holds
+    // - nearest neighbor insert batching
+    //    - tag::insert_batch<N> - each worker publishes its new nodes
+    //      to the shared nearest neighbor structure N at a time.
+    // - pipelined execution
+    //    - tag::pipeline<S,N,V,I> - runs sampling, nearest neighbor
+    //      lookups, motion validation, and tree insertion as separate
+    //      stages with S, N, V, and I threads respectively.
+    // - batched sample processing
+    //    - tag::sample_batch<B> - each worker processes B samples at
+    //      a time.
+    // - asynchronous motion checks (for scenarios with linkAsync)
+    //    - tag::async_depth<N> - each worker keeps N samples in
+    //      flight (default 4).
+    // - reproducible planning
+    //    - tag::deterministic - the same seed and number of threads
+    //      produces the same result, at some cost in throughput.
+    // - node allocation
+    //    - tag::arena_pool<B,H> - allocates nodes from B-byte arenas,
+    //      backed by huge pages when H is true.
+    //    - tag::compact_graph - links nodes to their parents with
+    //      32-bit indices into a process-wide region instead of
+    //      pointers.
+    //    - tag::allocator<A> - allocates nodes and internal
+    //      containers with the allocator A.
+    // - memory limits
+    //    - tag::memory_budget<N> - solve() returns before the
+    //      planner's pools exceed about N bytes.
     template <typename ... Options>
     using PRRT = typename impl::PRRTOptions<Options...>::type;
 }
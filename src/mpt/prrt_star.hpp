@@ -40,6 +40,7 @@
 #include "planner.hpp"
 #include "planner_tags.hpp"
 #include "impl/nearest_strategy.hpp"
+#include "impl/pool_strategy.hpp"
 #include "impl/pack_nearest.hpp"
 #include "impl/packs.hpp"
 #include "impl/prrt_star/prrt_star.hpp"
@@ -48,7 +49,9 @@ namespace unc::robotics::mpt {
 
     namespace impl {
         // this is the actual strategy type for a PRRTStar planner
-        template <int maxThreads, bool kNearest, bool reportStats, typename NNStrategy>
+        template <int maxThreads, bool kNearest, bool reportStats, typename NNStrategy, bool deterministic,
+                  int sampleBatch, typename PoolStrategy, typename Allocator,
+                  std::size_t memoryBudget>
         struct PRRTStarStrategy {};
 
         // Option parser to generate a PRRTStarStrategy from a
@@ -59,22 +62,34 @@ namespace unc::robotics::mpt {
             static constexpr bool kNearest = pack_contains_v<rewire_k_nearest, Options...>;
             static constexpr bool rNearest = pack_contains_v<rewire_r_nearest, Options...>;
             static constexpr bool reportStats = pack_bool_tag_v<report_stats, false, Options...>;
+            static constexpr bool deterministic = pack_contains_v<mpt::deterministic, Options...>;
+            static constexpr int sampleBatch = pack_int_tag_v<sample_batch, 1, Options...>;
+            static constexpr std::size_t memoryBudget = pack_value_tag<
+                std::size_t, memory_budget, 0, Options...>::value;
 
             static_assert(!(kNearest && rNearest), "RRT* tags cannot include both k_nearest and r_nearest");
 
             using NNStrategy = pack_nearest_t<Options...>;
+            using PoolStrategy = pack_find_t<is_pool_strategy, void, Options...>;
+            using Allocator = pack_allocator_t<Options...>;
 
-            using type = PRRTStarStrategy<maxThreads, !rNearest, reportStats, NNStrategy>;
+            using type = PRRTStarStrategy<
+                maxThreads, !rNearest, reportStats, NNStrategy, deterministic, sampleBatch,
+                PoolStrategy, Allocator, memoryBudget>;
         };
 
-        template <typename Scenario, int maxThreads, bool kNearest, bool reportStats, typename NNStrategy>
+        template <typename Scenario, int maxThreads, bool kNearest, bool reportStats, typename NNStrategy,
+                  bool deterministic, int sampleBatch, typename PoolStrategy, typename Allocator,
+                  std::size_t memoryBudget>
         struct PlannerResolver<
             Scenario,
             impl::PRRTStarStrategy<
-                maxThreads, kNearest, reportStats, NNStrategy>> {
+                maxThreads, kNearest, reportStats, NNStrategy, deterministic, sampleBatch,
+                PoolStrategy, Allocator, memoryBudget>> {
             using type = impl::prrt_star::PRRTStar<
                 Scenario, maxThreads, kNearest, reportStats,
-                nearest_strategy_t<Scenario, maxThreads, NNStrategy>>;
+                nearest_strategy_t<Scenario, maxThreads, NNStrategy>,
+                deterministic, sampleBatch, PoolStrategy, Allocator, memoryBudget>;
         };
     }
 
@@ -88,6 +103,22 @@ namespace unc::robotics::mpt {
     //    - nigh::KDTreeBatch<...> - fastest, supports concurrent operation, but does not support arbitrary metrics
     //    - nigh::Linear - slowest, supports concurrent operations, supports arbitrary metrics
     //    - nigh::GNAT<...> - fast, does NOT support concurrent operations, supports metrics for which triangle property holds
+    // - batched sample processing
+    //    - tag::sample_batch<B> - each worker processes B samples at
+    //      a time.
+    // - reproducible planning
+    //    - tag::deterministic - the same seed and number of threads
+    //      produces the same result, at some cost in throughput.
+    // - node allocation
+    //    - tag::arena_pool<B,H> - allocates nodes and links from
+    //      B-byte arenas, backed by huge pages when H is true.
+    //    - tag::compact_graph - links nodes and links with 32-bit
+    //      indices into a process-wide region instead of pointers.
+    //    - tag::allocator<A> - allocates nodes, links, and internal
+    //      containers with the allocator A.
+    // - memory limits
+    //    - tag::memory_budget<N> - solve() returns before the
+    //      planner's pools exceed about N bytes.
     template <typename ... Options>
     using PRRTStar = typename impl::PRRTStarOptions<Options...>::type;
 }
@@ -39,6 +39,7 @@
 #include <array>
 #include <random>
 #include <algorithm>
+#include <mutex>
 
 namespace unc::robotics::mpt {
 
@@ -58,10 +59,14 @@ namespace unc::robotics::mpt {
      * exactly enough for a MersenneTwister19937.
      *
      * @param _RDev is the underlying source of randomness to use.
+     *
+     * generate() may be called concurrently, as it is when planners
+     * construct their workers in parallel.
      */
     template <std::size_t _size = 624, typename _RDev = std::random_device>
     class RandomDeviceSeed {
         mutable _RDev rdev_;
+        mutable std::mutex mutex_;
 
     public:
         typedef std::uint32_t result_type;
@@ -77,7 +82,10 @@ namespace unc::robotics::mpt {
             std::size_t n = std::min(_size, std::size_t(std::distance(begin, end)));
             std::array<result_type, _size> data;
             std::uniform_int_distribution<std::uint32_t> dist32;
-            std::generate_n(data.begin(), n, [&] { return dist32(rdev_); });
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::generate_n(data.begin(), n, [&] { return dist32(rdev_); });
+            }
             std::seed_seq seq(data.begin(), data.begin() + n);
             seq.generate(begin, end);
         }
@@ -0,0 +1,328 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_SHARED_SEGMENT_HPP
+#define MPT_SHARED_SEGMENT_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace unc::robotics::mpt {
+
+    // A SharedSegment is a fixed-capacity region of POSIX shared
+    // memory that planners may allocate their graph from, so that
+    // multiple processes on the same host can build and query one
+    // roadmap.  Each process maps the segment at a (potentially)
+    // different address, thus structures allocated from it must use
+    // offset pointers (see impl/offset_ptr.hpp) instead of raw
+    // pointers.
+    //
+    // Allocation is a lock-free bump of a shared offset, and memory
+    // is never returned to the segment.  The objects in the segment
+    // are not destroyed, they outlive the processes that create them
+    // until the segment is unlinked.
+    //
+    // In addition to allocation, the segment has a few root lists,
+    // on which a process may record objects that other processes
+    // need to find (e.g., the nodes of a roadmap).  Each record
+    // stores the owner that recorded it, so that a process may skip
+    // the objects it recorded itself.
+    class SharedSegment {
+    public:
+        static constexpr unsigned kRoots = 4;
+
+    private:
+        static constexpr std::uint64_t kMagic = 0x4d50545345474d31ull; // "MPTSEGM1"
+
+        struct Header {
+            std::atomic<std::uint64_t> magic_{0};
+            std::uint64_t capacity_;
+            std::atomic<std::uint64_t> used_;
+            std::atomic<std::uint32_t> owners_{0};
+            std::atomic<std::uint64_t> roots_[kRoots];
+
+            Header(std::uint64_t capacity)
+                : capacity_(capacity)
+                , used_(sizeof(Header))
+            {
+                for (auto& root : roots_)
+                    root.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        struct Record {
+            std::uint64_t next_;
+            std::uint64_t target_;
+            std::uint32_t owner_;
+        };
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                      "shared segments require lock-free 64-bit atomics");
+
+        std::string name_;
+        char *base_{nullptr};
+        std::size_t size_{0};
+
+        SharedSegment(std::string name, char *base, std::size_t size)
+            : name_(std::move(name))
+            , base_(base)
+            , size_(size)
+        {
+        }
+
+        Header& header() const {
+            return *reinterpret_cast<Header*>(base_);
+        }
+
+        static std::system_error error(const std::string& what) {
+            return std::system_error(errno, std::generic_category(), what);
+        }
+
+        static char* map(int fd, std::size_t size) {
+            void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            return p == MAP_FAILED ? nullptr : static_cast<char*>(p);
+        }
+
+    public:
+        SharedSegment(const SharedSegment&) = delete;
+        SharedSegment& operator = (const SharedSegment&) = delete;
+
+        SharedSegment(SharedSegment&& other)
+            : name_(std::move(other.name_))
+            , base_(std::exchange(other.base_, nullptr))
+            , size_(std::exchange(other.size_, 0))
+        {
+        }
+
+        ~SharedSegment() {
+            if (base_)
+                ::munmap(base_, size_);
+        }
+
+        // Creates a new segment with the specified name and capacity
+        // in bytes.  Throws if the segment already exists.
+        static SharedSegment create(const std::string& name, std::size_t capacity) {
+            if (capacity <= sizeof(Header))
+                throw std::invalid_argument("shared segment capacity is too small");
+
+            int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd == -1)
+                throw error("shm_open " + name);
+
+            char *base = nullptr;
+            if (::ftruncate(fd, capacity) == 0)
+                base = map(fd, capacity);
+            int err = errno;
+            ::close(fd);
+            if (base == nullptr) {
+                ::shm_unlink(name.c_str());
+                errno = err;
+                throw error("mapping " + name);
+            }
+
+            // the magic number is stored last so that processes
+            // opening the segment see an initialized header.
+            Header *header = new (base) Header(capacity);
+            header->magic_.store(kMagic, std::memory_order_release);
+            return SharedSegment(name, base, capacity);
+        }
+
+        // Opens an existing segment created by create().  The
+        // creating process may not have sized or initialized the
+        // segment yet (e.g., when processes start together and race
+        // in openOrCreate()), thus this waits up to 'timeout' for it
+        // to do so before throwing.
+        static SharedSegment open(
+            const std::string& name,
+            std::chrono::milliseconds timeout = std::chrono::seconds(5))
+        {
+            using Clock = std::chrono::steady_clock;
+            constexpr auto kPoll = std::chrono::milliseconds(1);
+            Clock::time_point deadline = Clock::now() + timeout;
+
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+            if (fd == -1)
+                throw error("shm_open " + name);
+
+            // create() sizes the segment before mapping it.
+            struct stat st;
+            for (;;) {
+                if (::fstat(fd, &st) != 0) {
+                    int err = errno;
+                    ::close(fd);
+                    errno = err;
+                    throw error("fstat " + name);
+                }
+                if (std::size_t(st.st_size) > sizeof(Header))
+                    break;
+                if (Clock::now() >= deadline) {
+                    ::close(fd);
+                    throw std::runtime_error("shared segment " + name + " is not initialized");
+                }
+                std::this_thread::sleep_for(kPoll);
+            }
+
+            char *base = map(fd, st.st_size);
+            int err = errno;
+            ::close(fd);
+            if (base == nullptr) {
+                errno = err;
+                throw error("mapping " + name);
+            }
+
+            // and stores the magic number after the header.
+            SharedSegment segment(name, base, st.st_size);
+            while (segment.header().magic_.load(std::memory_order_acquire) != kMagic) {
+                if (Clock::now() >= deadline)
+                    throw std::runtime_error("shared segment " + name + " is not initialized");
+                std::this_thread::sleep_for(kPoll);
+            }
+            return segment;
+        }
+
+        // Opens the segment if it exists, otherwise creates it.
+        static SharedSegment openOrCreate(const std::string& name, std::size_t capacity) {
+            try {
+                return create(name, capacity);
+            } catch (const std::system_error& ex) {
+                if (ex.code() != std::errc::file_exists)
+                    throw;
+            }
+            return open(name);
+        }
+
+        // Removes the segment's name.  Processes that have the
+        // segment mapped may continue to use it.
+        static void unlink(const std::string& name) {
+            ::shm_unlink(name.c_str());
+        }
+
+        const std::string& name() const {
+            return name_;
+        }
+
+        std::size_t capacity() const {
+            return header().capacity_;
+        }
+
+        std::size_t used() const {
+            return header().used_.load(std::memory_order_relaxed);
+        }
+
+        bool contains(const void *p) const {
+            const char *c = static_cast<const char*>(p);
+            return base_ <= c && c < base_ + size_;
+        }
+
+        // Allocates uninitialized memory from the segment.  Throws
+        // std::bad_alloc when the segment is full.
+        void* allocate(std::size_t size, std::size_t align) {
+            std::atomic<std::uint64_t>& used = header().used_;
+            std::uint64_t offset = used.load(std::memory_order_relaxed);
+            std::uint64_t start;
+            do {
+                start = (offset + align - 1) & ~std::uint64_t(align - 1);
+                if (start + size > header().capacity_)
+                    throw std::bad_alloc();
+            } while (!used.compare_exchange_weak(
+                         offset, start + size, std::memory_order_relaxed));
+            return base_ + start;
+        }
+
+        template <typename T, typename ... Args>
+        T* construct(Args&& ... args) {
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // Returns a new owner id, unique among the processes using
+        // the segment.  Owner ids start at 1.
+        unsigned newOwner() {
+            return header().owners_.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        // Records an object (which must be in the segment) on the
+        // specified root list.
+        void record(unsigned root, const void *p, unsigned owner) {
+            assert(root < kRoots && contains(p));
+            Record *r = construct<Record>();
+            r->target_ = static_cast<const char*>(p) - base_;
+            r->owner_ = owner;
+            std::uint64_t offset = reinterpret_cast<char*>(r) - base_;
+            std::atomic<std::uint64_t>& head = header().roots_[root];
+            r->next_ = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(
+                       r->next_, offset,
+                       std::memory_order_release,
+                       std::memory_order_relaxed))
+                ;
+        }
+
+        // Returns the position of the most recent record on a root
+        // list, to pass to forEach() as the position to stop at.
+        std::uint64_t head(unsigned root) const {
+            return header().roots_[root].load(std::memory_order_acquire);
+        }
+
+        // Calls fn(object, owner) for each record on a root list,
+        // starting at position 'from' and going from most recent to
+        // oldest, stopping when it reaches the record at position
+        // 'until'.  Both positions are values returned by head() for
+        // the same root.
+        template <typename T, typename Fn>
+        void forEach(std::uint64_t from, std::uint64_t until, Fn&& fn) const {
+            for (std::uint64_t offset = from ; offset != until && offset != 0 ; ) {
+                const Record *r = reinterpret_cast<const Record*>(base_ + offset);
+                fn(reinterpret_cast<T*>(base_ + r->target_), r->owner_);
+                offset = r->next_;
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_STATE_CODEC_HPP
+#define MPT_STATE_CODEC_HPP
+
+namespace unc::robotics::mpt {
+    // A StateCodec compresses states of a Space within its Bounds to
+    // a compact Encoded type, and restores them.  Decoding is lossy,
+    // but deterministic: the same encoding always decodes to the same
+    // state.  Planners that store compressed states (see the
+    // quantized_states tag) thus check the decoded state, and the
+    // stored states are exactly the states that were checked.
+    //
+    // Specializations provide:
+    //
+    //   using Type = ...;     // the state type
+    //   using Encoded = ...;  // the compressed state type
+    //   StateCodec(const Space&, const Bounds&);
+    //   Encoded encode(const Type&) const;
+    //   Type decode(const Encoded&) const;
+    //
+    // Encoded must not own memory outside of itself, so that it can
+    // be stored in a shared roadmap.
+    template <typename Space, typename Bounds>
+    struct StateCodec;
+}
+
+#include "impl/state_codec_lp.hpp"
+#include "impl/state_codec_so3.hpp"
+#include "impl/state_codec_scaled.hpp"
+#include "impl/state_codec_cartesian.hpp"
+
+namespace unc::robotics::mpt::impl {
+    // the type a planner stores for each state: the Codec's encoding,
+    // or the state itself when Codec is void.
+    template <typename Codec, typename State>
+    struct codec_encoded {
+        using type = typename Codec::Encoded;
+    };
+
+    template <typename State>
+    struct codec_encoded<void, State> {
+        using type = State;
+    };
+
+    template <typename Codec, typename State>
+    using codec_encoded_t = typename codec_encoded<Codec, State>::type;
+}
+
+#endif
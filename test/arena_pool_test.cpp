@@ -0,0 +1,144 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/arena_pool.hpp>
+#include "test.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace unc::robotics::mpt::impl;
+
+namespace {
+    struct Counted {
+        static inline int live = 0;
+        int value_;
+        Counted(int v) : value_(v) { ++live; }
+        ~Counted() { --live; }
+    };
+
+    struct alignas(16) Odd {
+        char data_[40];
+    };
+}
+
+TEST(slot_size) {
+    EXPECT((ArenaPool<char>::kSlotSize)) == 1u;
+    EXPECT((ArenaPool<Odd>::kSlotSize)) == 64u;
+    EXPECT((ArenaPool<char[65]>::kSlotSize)) == 128u;
+    EXPECT((ArenaPool<char[24]>::kSlotSize)) == 32u;
+}
+
+TEST(allocate) {
+    ArenaPool<Counted, 256> pool;
+    std::vector<Counted*> ptrs;
+    for (int i = 0 ; i < 100 ; ++i)
+        ptrs.push_back(pool.allocate(i));
+    EXPECT(pool.size()) == 100u;
+    // objects do not move as the pool grows
+    bool stable = true;
+    for (int i = 0 ; i < 100 ; ++i)
+        stable &= ptrs[i]->value_ == i;
+    EXPECT(stable) == true;
+}
+
+TEST(index) {
+    ArenaPool<Counted, 256> pool;
+    for (int i = 0 ; i < 100 ; ++i)
+        pool.allocate(i);
+    bool ordered = true;
+    for (int i = 0 ; i < 100 ; ++i)
+        ordered &= pool[i].value_ == i;
+    EXPECT(ordered) == true;
+}
+
+TEST(alignment) {
+    ArenaPool<Odd, 4096> pool;
+    bool aligned = true;
+    for (int i = 0 ; i < 200 ; ++i)
+        aligned &= reinterpret_cast<std::uintptr_t>(pool.allocate()) % 64 == 0;
+    EXPECT(aligned) == true;
+}
+
+TEST(destroy) {
+    {
+        ArenaPool<Counted, 256> pool;
+        for (int i = 0 ; i < 37 ; ++i)
+            pool.allocate(i);
+        EXPECT(Counted::live) == 37;
+        ArenaPool<Counted, 256> moved(std::move(pool));
+        EXPECT(pool.size()) == 0u;
+        EXPECT(moved.size()) == 37u;
+    }
+    EXPECT(Counted::live) == 0;
+}
+
+TEST(huge_pages) {
+    ArenaPool<Counted, (std::size_t(2) << 20), true> pool;
+    Counted *p = pool.allocate(7);
+    EXPECT(p->value_) == 7;
+    EXPECT(reinterpret_cast<std::uintptr_t>(p) % (std::size_t(2) << 20)) == 0u;
+}
+
+namespace {
+    template <typename T>
+    struct CountingAllocator {
+        using value_type = T;
+        static inline long live = 0;
+
+        CountingAllocator() = default;
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(std::size_t n) {
+            CountingAllocator<char>::live += n * sizeof(T);
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n) {
+            CountingAllocator<char>::live -= n * sizeof(T);
+            std::allocator<T>().deallocate(p, n);
+        }
+    };
+}
+
+TEST(allocator) {
+    {
+        ArenaPool<Counted, 4096, false, CountingAllocator<Counted>> pool;
+        for (int i = 0 ; i < 1000 ; ++i)
+            pool.allocate(i);
+        EXPECT(CountingAllocator<char>::live >= 4096) == true;
+    }
+    EXPECT(CountingAllocator<char>::live) == 0;
+}
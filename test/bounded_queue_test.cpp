@@ -0,0 +1,100 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/bounded_queue.hpp>
+#include "test.hpp"
+#include <thread>
+
+using namespace unc::robotics::mpt::impl;
+
+TEST(fifo) {
+    BoundedQueue<int> q(4);
+    EXPECT(q.capacity()) == 4u;
+    for (int i=0 ; i<4 ; ++i)
+        EXPECT(q.tryPush(int(i))) == true;
+    EXPECT(q.tryPush(4)) == false;
+
+    int value;
+    for (int i=0 ; i<4 ; ++i) {
+        EXPECT(q.tryPop(value)) == true;
+        EXPECT(value) == i;
+    }
+    EXPECT(q.tryPop(value)) == false;
+}
+
+TEST(wrap_around) {
+    BoundedQueue<int> q(2);
+    int value;
+    for (int i=0 ; i<10 ; ++i) {
+        EXPECT(q.tryPush(int(i))) == true;
+        EXPECT(q.tryPop(value)) == true;
+        EXPECT(value) == i;
+    }
+}
+
+TEST(concurrent) {
+    constexpr int nProducers = 2;
+    constexpr int nConsumers = 2;
+    constexpr long nPerProducer = 20000;
+
+    BoundedQueue<long> q(64);
+    std::atomic<long> sum{0};
+    std::atomic<long> count{0};
+
+    std::vector<std::thread> threads;
+    for (int p=0 ; p<nProducers ; ++p)
+        threads.emplace_back([&] {
+            for (long i=1 ; i<=nPerProducer ; ++i)
+                while (!q.tryPush(long(i)))
+                    std::this_thread::yield();
+        });
+    for (int c=0 ; c<nConsumers ; ++c)
+        threads.emplace_back([&] {
+            long value;
+            while (count.load() < nProducers * nPerProducer) {
+                if (q.tryPop(value)) {
+                    sum += value;
+                    ++count;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT(count.load()) == nProducers * nPerProducer;
+    EXPECT(sum.load()) == nProducers * nPerProducer * (nPerProducer + 1) / 2;
+}
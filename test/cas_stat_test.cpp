@@ -0,0 +1,80 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/cas_stat.hpp>
+#include "test.hpp"
+
+using namespace unc::robotics::mpt::impl;
+
+TEST(counts) {
+    CASStat<> stat;
+    stat += 0;
+    stat += 0;
+    stat += 1;
+    stat += 5;
+    EXPECT(stat.ops()) == 4u;
+    EXPECT(stat.retries()) == 6u;
+    EXPECT(stat.maxRetries()) == 5u;
+    EXPECT(stat.histogram(0)) == 2u; // 0
+    EXPECT(stat.histogram(1)) == 1u; // 1
+    EXPECT(stat.histogram(2)) == 0u; // 2-3
+    EXPECT(stat.histogram(3)) == 1u; // 4-7
+}
+
+TEST(overflow_bucket) {
+    CASStat<> stat;
+    stat += ~0u;
+    EXPECT(stat.histogram(CASStat<>::kBuckets - 1)) == 1u;
+}
+
+TEST(sum) {
+    CASStat<> a, b;
+    a += 2;
+    b += 3;
+    b += 9;
+    a += b;
+    EXPECT(a.ops()) == 3u;
+    EXPECT(a.retries()) == 14u;
+    EXPECT(a.maxRetries()) == 9u;
+    EXPECT(a.histogram(2)) == 2u;
+    EXPECT(a.histogram(4)) == 1u;
+}
+
+TEST(disabled) {
+    // the disabled version accepts the same operations and does
+    // nothing.
+    CASStat<false>::instance() += 3;
+    EXPECT(sizeof(CASStat<false>)) == 1u;
+}
@@ -0,0 +1,152 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/compact_ptr.hpp>
+#include "test.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace unc::robotics::mpt::impl;
+
+namespace {
+    struct Counted {
+        static inline int live = 0;
+        int value_;
+        CompactPtr<Counted> next_;
+        Counted(int v, Counted *next = nullptr) : value_(v), next_(next) { ++live; }
+        ~Counted() { --live; }
+    };
+
+    struct alignas(16) Odd {
+        char data_[20];
+    };
+}
+
+TEST(size) {
+    EXPECT(sizeof(CompactPtr<int>)) == 4u;
+    EXPECT(sizeof(AtomicCompactPtr<int>)) == 4u;
+    EXPECT((CompactPool<char>::kSlotSize)) == 8u;
+    EXPECT((CompactPool<Odd>::kSlotSize)) == 32u;
+}
+
+TEST(null) {
+    CompactPtr<int> p;
+    EXPECT(p.get() == nullptr) == true;
+    AtomicCompactPtr<int> a(nullptr);
+    EXPECT(a.load() == nullptr) == true;
+}
+
+TEST(list) {
+    CompactPool<Counted> pool;
+    Counted *head = nullptr;
+    for (int i = 0 ; i < 10000 ; ++i)
+        head = pool.allocate(i, head);
+    EXPECT(pool.size()) == 10000u;
+    int expect = 9999;
+    bool linked = true;
+    for (Counted *c = head ; c ; c = c->next_)
+        linked &= c->value_ == expect--;
+    EXPECT(linked) == true;
+    EXPECT(expect) == -1;
+}
+
+TEST(atomic) {
+    CompactPool<int> pool;
+    int *a = pool.allocate(1);
+    int *b = pool.allocate(2);
+    AtomicCompactPtr<int> p(a);
+    int *expected = b;
+    EXPECT(p.compare_exchange_strong(expected, b, std::memory_order_relaxed, std::memory_order_relaxed)) == false;
+    EXPECT(expected == a) == true;
+    EXPECT(p.compare_exchange_strong(expected, b, std::memory_order_relaxed, std::memory_order_relaxed)) == true;
+    EXPECT(*p.load()) == 2;
+}
+
+TEST(alignment) {
+    CompactPool<Odd> pool;
+    bool aligned = true;
+    for (int i = 0 ; i < 5000 ; ++i)
+        aligned &= reinterpret_cast<std::uintptr_t>(pool.allocate()) % 16 == 0;
+    EXPECT(aligned) == true;
+}
+
+TEST(destroy) {
+    {
+        CompactPool<Counted> pool;
+        for (int i = 0 ; i < 37 ; ++i)
+            pool.allocate(i);
+        EXPECT(Counted::live) == 37;
+        CompactPool<Counted> moved(std::move(pool));
+        EXPECT(pool.size()) == 0u;
+        EXPECT(moved.size()) == 37u;
+        moved.clear();
+        EXPECT(Counted::live) == 0;
+        EXPECT(moved.bytes()) == CompactHeap::kBlockSize;
+    }
+    EXPECT(Counted::live) == 0;
+}
+
+TEST(reuse_blocks) {
+    char *first;
+    {
+        CompactPool<int> pool;
+        first = reinterpret_cast<char*>(pool.allocate(1));
+    }
+    CompactPool<int> pool;
+    EXPECT(reinterpret_cast<char*>(pool.allocate(2)) == first) == true;
+}
+
+TEST(encode_outside_heap) {
+    CompactPool<int> pool;
+    char *p = reinterpret_cast<char*>(pool.allocate(1));
+    int local = 0;
+    bool threw = false;
+    try {
+        CompactHeap::encode(&local);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT(threw) == true;
+
+    threw = false;
+    try {
+        CompactHeap::encode(p + 1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT(threw) == true;
+    EXPECT(CompactHeap::decode<char>(CompactHeap::encode(p)) == p) == true;
+}
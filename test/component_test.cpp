@@ -0,0 +1,143 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/pprm/component.hpp>
+#include "test.hpp"
+#include <deque>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace unc::robotics::mpt::impl::pprm;
+
+TEST(merge) {
+    Component s(Component::kStart);
+    Component a(Component::kNone);
+    Component g(Component::kGoal);
+    EXPECT(s.size()) == 1u;
+    EXPECT(s.isStart()) == true;
+    EXPECT(s.isSolution()) == false;
+
+    Component *r = Component::merge(&a, &g);
+    EXPECT(r == a.find()) == true;
+    EXPECT(r == g.find()) == true;
+    EXPECT(a.size()) == 2u;
+    EXPECT(a.isGoal()) == true;
+    EXPECT(a.isStart()) == false;
+    EXPECT(Component::merge(&g, &a) == r) == true;
+    EXPECT(a.size()) == 2u;
+
+    Component::merge(&s, &a);
+    EXPECT(g.size()) == 3u;
+    EXPECT(s.find() == g.find()) == true;
+    EXPECT(g.isSolution()) == true;
+}
+
+// Threads concurrently merge random pairs of a shared set of
+// elements.  Since union is commutative and associative, the result
+// must be the same partition as a sequential union-find applying the
+// same merges, with the same sizes and start/goal flags.  There are
+// slightly fewer merges than half the elements, so that the result
+// has many components of varied sizes rather than one.
+TEST(concurrent_merge) {
+    constexpr int nElements = 20000;
+    constexpr int nThreads = 8;
+    constexpr int nPerThread = 1200;
+
+    for (int round = 0 ; round < 8 ; ++round) {
+        std::mt19937 rng(round);
+        std::vector<Component::Flags> flags(nElements);
+        for (auto& f : flags)
+            f = static_cast<Component::Flags>(rng() % 64 == 0 ? 1 + rng() % 2 : 0);
+
+        std::deque<Component> elements;
+        for (int i=0 ; i<nElements ; ++i)
+            elements.emplace_back(flags[i]);
+
+        std::vector<std::pair<int, int>> merges(nThreads * nPerThread);
+        for (auto& m : merges)
+            m = { int(rng() % nElements), int(rng() % nElements) };
+
+        std::vector<std::thread> threads;
+        for (int t=0 ; t<nThreads ; ++t)
+            threads.emplace_back([&, t] {
+                for (int i=t*nPerThread ; i<(t+1)*nPerThread ; ++i)
+                    Component::merge(&elements[merges[i].first], &elements[merges[i].second]);
+            });
+        for (auto& thread : threads)
+            thread.join();
+
+        // sequential union-find over the same merges
+        std::vector<int> parent(nElements);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&] (int x) {
+            while (parent[x] != x)
+                x = parent[x] = parent[parent[x]];
+            return x;
+        };
+        for (auto& m : merges)
+            parent[find(m.first)] = find(m.second);
+
+        std::vector<std::size_t> sizes(nElements);
+        std::vector<unsigned> rootFlags(nElements);
+        for (int i=0 ; i<nElements ; ++i) {
+            ++sizes[find(i)];
+            rootFlags[find(i)] |= flags[i];
+        }
+
+        // the partitions match if each expected root maps to one
+        // component root, and vice versa.
+        std::unordered_map<int, Component*> toComponent;
+        std::unordered_map<Component*, int> toExpected;
+        bool samePartition = true;
+        bool sameSize = true;
+        bool sameFlags = true;
+        for (int i=0 ; i<nElements ; ++i) {
+            int r = find(i);
+            Component *c = elements[i].find();
+            samePartition &= toComponent.emplace(r, c).first->second == c;
+            samePartition &= toExpected.emplace(c, r).first->second == r;
+            sameSize &= elements[i].size() == sizes[r];
+            sameFlags &= elements[i].isStart() == ((rootFlags[r] & Component::kStart) != 0);
+            sameFlags &= elements[i].isGoal() == ((rootFlags[r] & Component::kGoal) != 0);
+            sameFlags &= elements[i].isSolution() == (rootFlags[r] == Component::kSolution);
+        }
+        EXPECT(samePartition) == true;
+        EXPECT(sameSize) == true;
+        EXPECT(sameFlags) == true;
+    }
+}
@@ -49,13 +49,13 @@ VERSIONS=$($PKG_CONFIG --modversion $DEPS) || die "required dependency is missin
 DEPS_ALL=$((printf "%s\n" $DEPS ; $PKG_CONFIG --print-requires $DEPS) | sort | uniq)
 
 CFLAGS="${CFLAGS:--O3 -march=native}"
-CFLAGS+=" -std=c++17 -I../src -I../../nigh/src"
+CFLAGS+=" -std=c++17 -fopenmp -I../src -I../../nigh/src"
 CFLAGS+=" $($PKG_CONFIG --cflags-only-I $DEPS_ALL)"
 LIBS="$($PKG_CONFIG --libs eigen3 $DEPS_ALL)"
 
 case `uname` in
     Linux)
-        LIBS+=" -lpthread"
+        LIBS+=" -lpthread -lrt"
     ;;
 esac
 
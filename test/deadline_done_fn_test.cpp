@@ -0,0 +1,87 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/deadline_done_fn.hpp>
+#include "test.hpp"
+#include <thread>
+
+using namespace unc::robotics::mpt::impl;
+using namespace std::literals;
+
+TEST(deadline) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto done = deadlineDoneFn(start + 10ms);
+    std::size_t calls = 0;
+    while (!done())
+        ++calls;
+    auto elapsed = Clock::now() - start;
+    EXPECT(elapsed >= 10ms) == true;
+    // overshoot is bounded by about one poll period, allow plenty
+    // of slack for a loaded machine.
+    EXPECT(elapsed < 100ms) == true;
+    // cheap iterations should not read the clock on every call
+    EXPECT(done.interval() > 1u) == true;
+    // once done, it remains done
+    EXPECT(done()) == true;
+}
+
+TEST(expired) {
+    auto done = deadlineDoneFn(std::chrono::steady_clock::now() - 1s);
+    EXPECT(done()) == true;
+}
+
+TEST(predicate) {
+    int count = 0;
+    auto done = deadlineDoneFn(std::chrono::steady_clock::now() + 1h, [&] { return ++count >= 5; });
+    int calls = 1;
+    while (!done())
+        ++calls;
+    EXPECT(calls) == 5;
+    EXPECT(done()) == true;
+    EXPECT(count) == 5;
+}
+
+TEST(slow_iterations) {
+    // when each iteration takes longer than the poll period, the
+    // clock should be read on every call.
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto done = deadlineDoneFn(start + 20ms);
+    while (!done())
+        std::this_thread::sleep_for(1ms);
+    EXPECT(done.interval()) == 1u;
+    EXPECT(Clock::now() - start < 200ms) == true;
+}
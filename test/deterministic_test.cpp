@@ -0,0 +1,86 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/pprm.hpp>
+#include <mpt/prrt.hpp>
+#include <mpt/prrt_star.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+
+using namespace unc::robotics::mpt;
+
+template <typename Algorithm>
+static std::vector<PointScenario::State> solveOnce(std::uint64_t seed, std::size_t& size) {
+    Planner<PointScenario, Algorithm> planner(PointScenario{}, FixedSeed(seed));
+    planner.addStart(PointScenario::start());
+    planner.solve([&] { return planner.size() >= 500; });
+    size = planner.size();
+    return planner.solution();
+}
+
+// two runs with the same seed and number of threads must build the
+// same graph, and thus find the same path.
+template <typename Algorithm>
+static void expectReproducible() {
+    std::size_t size1, size2;
+    auto path1 = solveOnce<Algorithm>(5, size1);
+    auto path2 = solveOnce<Algorithm>(5, size2);
+    EXPECT(PointScenario{}.validPath(path1)) == true;
+    EXPECT(size1) == size2;
+    EXPECT(path1 == path2) == true;
+}
+
+TEST(prrt) {
+    expectReproducible<PRRT<max_threads<4>, deterministic>>();
+}
+
+TEST(prrt_insert_batch) {
+    expectReproducible<PRRT<max_threads<4>, insert_batch<8>, deterministic>>();
+}
+
+TEST(prrt_star) {
+    expectReproducible<PRRTStar<max_threads<4>, deterministic>>();
+}
+
+TEST(pprm) {
+    expectReproducible<PPRM<max_threads<4>, deterministic>>();
+}
+
+TEST(seeds_differ) {
+    std::size_t size1, size2;
+    auto path1 = solveOnce<PRRT<max_threads<4>, deterministic>>(5, size1);
+    auto path2 = solveOnce<PRRT<max_threads<4>, deterministic>>(6, size2);
+    EXPECT(path1 == path2) == false;
+}
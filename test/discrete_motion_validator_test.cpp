@@ -0,0 +1,112 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/lp_space.hpp>
+#include <mpt/discrete_motion_validator.hpp>
+#include "test.hpp"
+#include <atomic>
+#include <random>
+#include <omp.h>
+
+using namespace unc::robotics::mpt;
+
+namespace {
+    using PlaneSpace = L2Space<double, 2>;
+    using State = PlaneSpace::Type;
+
+    // rejects states whose x coordinate is in (lo, hi).  Thread-safe,
+    // as required by splitting.
+    struct WindowValidator {
+        double lo_;
+        double hi_;
+
+        WindowValidator(double lo, double hi) : lo_(lo), hi_(hi) {}
+
+        bool operator() (const State& q) const {
+            return !(lo_ < q[0] && q[0] < hi_);
+        }
+    };
+
+    using Validator = DiscreteMotionValidator<PlaneSpace, WindowValidator>;
+
+    // checks the motion from a team of threads, so that the motion
+    // is split into tasks.
+    bool splitCheck(const Validator& validator, const State& from, const State& to) {
+        bool valid = false;
+#pragma omp parallel num_threads(4)
+#pragma omp single
+        valid = validator(from, to);
+        return valid;
+    }
+}
+
+TEST(valid) {
+    Validator validator(PlaneSpace(), 0.001, 2.0, 3.0);
+    validator.setSplitSteps(64);
+    EXPECT(splitCheck(validator, State(0, 0), State(1, 0))) == true;
+    EXPECT(validator(State(0, 0), State(1, 0))) == true;
+}
+
+// the motion has 1000 steps, and only the interior step at x = 0.371
+// is invalid.
+TEST(one_invalid_step) {
+    Validator validator(PlaneSpace(), 0.001, 0.3705, 0.3715);
+    validator.setSplitSteps(64);
+    EXPECT(splitCheck(validator, State(0, 0), State(1, 0))) == false;
+    EXPECT(validator(State(0, 0), State(1, 0))) == false;
+    EXPECT(splitCheck(validator, State(0, 0), State(0.37, 0))) == true;
+}
+
+// random motions and windows give the same result split or not.
+TEST(matches_bisection) {
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> dist(0, 1);
+    int mismatches = 0;
+    int invalid = 0;
+    for (int i=0 ; i<200 ; ++i) {
+        double lo = dist(rng);
+        Validator validator(PlaneSpace(), 0.0005, lo, lo + dist(rng) * 0.002);
+        validator.setSplitSteps(16);
+        State from(dist(rng), dist(rng));
+        State to(dist(rng), dist(rng));
+        if (!validator(from))
+            continue;
+        bool unsplit = validator(from, to);
+        invalid += !unsplit;
+        mismatches += splitCheck(validator, from, to) != unsplit;
+    }
+    EXPECT(mismatches) == 0;
+    EXPECT(invalid > 0) == true;
+}
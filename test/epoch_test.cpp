@@ -0,0 +1,90 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/epoch.hpp>
+#include "test.hpp"
+
+using namespace unc::robotics::mpt::impl;
+
+TEST(advance_inactive) {
+    EpochDomain<> domain(3);
+    EXPECT(domain.current()) == 0u;
+    EXPECT(domain.tryAdvance()) == true;
+    EXPECT(domain.current()) == 1u;
+}
+
+TEST(advance_blocked) {
+    EpochDomain<> domain(2);
+    domain.enter(0);
+    EXPECT(domain.tryAdvance()) == true;
+    // participant 0 is still in epoch 0
+    EXPECT(domain.tryAdvance()) == false;
+    EXPECT(domain.current()) == 1u;
+    domain.leave(0);
+    EXPECT(domain.tryAdvance()) == true;
+    EXPECT(domain.current()) == 2u;
+}
+
+TEST(guard) {
+    EpochDomain<> domain(1);
+    {
+        EpochGuard<true> guard(domain, 0);
+        EXPECT(domain.tryAdvance()) == true;
+        EXPECT(domain.tryAdvance()) == false;
+    }
+    EXPECT(domain.tryAdvance()) == true;
+}
+
+TEST(limbo) {
+    EpochDomain<> domain(1);
+    EpochLimbo<int> limbo;
+    int a, b;
+    limbo.retire(&a, domain.current());
+    domain.tryAdvance();
+    limbo.retire(&b, domain.current());
+    limbo.reclaim(domain.current());
+    EXPECT(limbo.reuse()) == nullptr;
+
+    domain.tryAdvance();
+    limbo.reclaim(domain.current());
+    EXPECT(limbo.retired()) == 1u;
+    EXPECT(limbo.reuse()) == &a;
+    EXPECT(limbo.reuse()) == nullptr;
+
+    domain.tryAdvance();
+    limbo.reclaim(domain.current());
+    EXPECT(limbo.reuse()) == &b;
+    EXPECT(limbo.retired()) == 0u;
+}
@@ -0,0 +1,86 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/fixed_seed.hpp>
+#include <mpt/impl/worker_seed.hpp>
+#include <mpt/random_device_seed.hpp>
+#include <random>
+#include "test.hpp"
+
+using namespace unc::robotics::mpt;
+
+template <typename RNG>
+static bool sameStream(RNG& a, RNG& b) {
+    bool allMatch = true;
+    for (int i=0 ; i < 128 ; ++i)
+        allMatch &= (a() == b());
+    return allMatch;
+}
+
+TEST(reproducible) {
+    FixedSeed seed(42);
+    std::mt19937_64 a(seed);
+    std::mt19937_64 b(seed);
+    EXPECT(sameStream(a, b)) == true;
+}
+
+TEST(different_values) {
+    const FixedSeed seed1(1), seed2(2);
+    std::mt19937_64 a(seed1);
+    std::mt19937_64 b(seed2);
+    EXPECT(sameStream(a, b)) == false;
+}
+
+TEST(worker_seed_reproducible) {
+    FixedSeed seed(7);
+    auto a = impl::workerRNG<std::mt19937_64>(seed, 3);
+    auto b = impl::workerRNG<std::mt19937_64>(seed, 3);
+    EXPECT(sameStream(a, b)) == true;
+}
+
+TEST(worker_seed_distinct) {
+    FixedSeed seed(7);
+    auto a = impl::workerRNG<std::mt19937_64>(seed, 0);
+    auto b = impl::workerRNG<std::mt19937_64>(seed, 1);
+    EXPECT(sameStream(a, b)) == false;
+}
+
+TEST(worker_seed_random_device) {
+    // WorkerSeed works with any seed with a const generate()
+    RandomDeviceSeed<> seed;
+    auto a = impl::workerRNG<std::mt19937_64>(seed, 0);
+    auto b = impl::workerRNG<std::mt19937_64>(seed, 0);
+    EXPECT(sameStream(a, b)) == false;
+}
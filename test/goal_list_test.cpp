@@ -0,0 +1,93 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/goal_list.hpp>
+#include "test.hpp"
+#include <deque>
+#include <thread>
+
+using namespace unc::robotics::mpt::impl;
+
+TEST(empty) {
+    GoalList<int, double, false> list;
+    EXPECT(list.empty()) == true;
+    EXPECT(list.size()) == 0u;
+    EXPECT(list.best() == nullptr) == true;
+}
+
+TEST(best_cost) {
+    using List = GoalList<int, double, false>;
+    int nodes[4];
+    List::Goal a(&nodes[0], 3.0), b(&nodes[1], 1.0), c(&nodes[2], 2.0), d(&nodes[3], 0.5);
+    List list;
+    EXPECT(list.push(&a)) == true;
+    EXPECT(list.push(&b)) == true;
+    EXPECT(list.push(&c)) == false;
+    EXPECT(list.best()->node() == &nodes[1]) == true;
+    EXPECT(list.push(&d)) == true;
+    EXPECT(list.best()->cost()) == 0.5;
+    EXPECT(list.size()) == 4u;
+
+    std::size_t count = 0;
+    for (auto *g = list.head() ; g ; g = g->next())
+        ++count;
+    EXPECT(count) == 4u;
+}
+
+TEST(concurrent_push) {
+    using List = GoalList<int, double, true>;
+    constexpr int nThreads = 4;
+    constexpr int nPerThread = 1000;
+    std::deque<List::Goal> goals[nThreads];
+    List list;
+
+    std::vector<std::thread> threads;
+    for (int t=0 ; t<nThreads ; ++t)
+        threads.emplace_back([&, t] {
+            for (int i=0 ; i<nPerThread ; ++i) {
+                goals[t].emplace_back(nullptr, double(i*nThreads + t + 1));
+                list.push(&goals[t].back());
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    std::size_t count = 0;
+    for (auto *g = list.head() ; g ; g = g->next())
+        ++count;
+    EXPECT(count) == std::size_t(nThreads * nPerThread);
+    EXPECT(list.size()) == std::size_t(nThreads * nPerThread);
+    EXPECT(list.best()->cost()) == 1.0;
+}
@@ -0,0 +1,91 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/memory_budget.hpp>
+#include <mpt/impl/object_pool.hpp>
+#include "test.hpp"
+
+using namespace unc::robotics::mpt::impl;
+
+TEST(charge_granularity) {
+    constexpr std::size_t kChunk = MemoryBudget<1>::kChargeBytes;
+    MemoryBudget<(std::size_t(1) << 20)> budget;
+    MemoryCharge<(std::size_t(1) << 20)> charge;
+    charge.update(budget, kChunk - 1);
+    EXPECT(budget.used()) == 0u;
+    charge.update(budget, kChunk + 10);
+    EXPECT(budget.used()) == kChunk + 10;
+    // shrinking usage is never charged back
+    charge.update(budget, 5);
+    EXPECT(budget.used()) == kChunk + 10;
+    EXPECT(charge.charged()) == kChunk + 10;
+}
+
+TEST(done_fn) {
+    constexpr std::size_t kLimit = std::size_t(1) << 20;
+    MemoryBudget<kLimit> budget;
+    int calls = 0;
+    auto done = budget.doneFn(2, [&] { ++calls; return false; });
+    EXPECT(done()) == false;
+    EXPECT(budget.reached()) == false;
+    // within the slack of two workers' uncharged bytes
+    budget.charge(kLimit - 2 * MemoryBudget<kLimit>::kChargeBytes);
+    EXPECT(done()) == true;
+    EXPECT(budget.reached()) == true;
+    EXPECT(calls) == 1;
+}
+
+TEST(disabled) {
+    MemoryBudget<0> budget;
+    MemoryCharge<0> charge;
+    charge.update(budget, std::size_t(1) << 30);
+    auto done = budget.doneFn(4, [] { return false; });
+    EXPECT(done()) == false;
+    EXPECT(budget.used()) == 0u;
+    EXPECT(budget.reached()) == false;
+}
+
+TEST(pool_bytes) {
+    ObjectPool<double> blocked;
+    ObjectPool<double, false> listed;
+    for (int i = 0 ; i < 10 ; ++i) {
+        blocked.allocate(i);
+        listed.allocate(i);
+    }
+    EXPECT(blocked.size()) == 10u;
+    EXPECT(blocked.bytes()) == ObjectPool<double>::kBlockObjects * sizeof(double);
+    EXPECT(listed.size()) == 10u;
+    EXPECT(listed.bytes() >= 10 * sizeof(double)) == true;
+}
@@ -0,0 +1,90 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/memory_stats.hpp>
+#include <mpt/impl/object_pool.hpp>
+#include "test.hpp"
+
+using namespace unc::robotics::mpt::impl;
+
+TEST(add_merges_by_name) {
+    MemoryStats stats;
+    stats.add("nodes", 2, 64);
+    stats.add("edges", 3, 48);
+    std::string name("nodes"); // a distinct pointer to an equal name
+    stats.add(name.c_str(), 1, 32);
+    EXPECT(stats.objects("nodes")) == 3u;
+    EXPECT(stats.bytes("nodes")) == 96u;
+    EXPECT(stats.objects("edges")) == 3u;
+    EXPECT(stats.objects("links")) == 0u;
+    EXPECT(stats.bytes()) == 144u;
+}
+
+TEST(sum) {
+    MemoryStats a, b;
+    a.add("nodes", 1, 10);
+    b.add("nodes", 2, 20);
+    b.add("edges", 4, 40);
+    a += b;
+    EXPECT(a.objects("nodes")) == 3u;
+    EXPECT(a.bytes("edges")) == 40u;
+    EXPECT(a.bytes()) == 70u;
+}
+
+TEST(pools_and_vectors) {
+    ObjectPool<int> pool;
+    pool.allocate(1);
+    pool.allocate(2);
+    std::vector<double> vec;
+    vec.reserve(10);
+    vec.push_back(1.0);
+    MemoryStats stats;
+    stats.addPool("pool", pool);
+    stats.addVector("vec", vec);
+    EXPECT(stats.objects("pool")) == 2u;
+    EXPECT(stats.bytes("pool")) == pool.bytes();
+    EXPECT(stats.objects("vec")) == 1u;
+    EXPECT(stats.bytes("vec")) == 10 * sizeof(double);
+}
+
+TEST(move) {
+    MemoryStats stats;
+    stats.add("links", 10, 100);
+    stats.move("links", "superseded links", 4, 40);
+    EXPECT(stats.objects("links")) == 6u;
+    EXPECT(stats.bytes("links")) == 60u;
+    EXPECT(stats.objects("superseded links")) == 4u;
+    EXPECT(stats.bytes()) == 100u;
+}
@@ -0,0 +1,144 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/planner_executor.hpp>
+#include "test.hpp"
+#include <stdexcept>
+
+using namespace unc::robotics::mpt;
+
+namespace {
+    // A minimal stand-in for a planner.  Each call to solve() runs
+    // until the done predicate returns true, counting the iterations
+    // along the way.  Since the executor may yield the planner and
+    // resume it later, the count is accumulated across calls.
+    struct CountingPlanner {
+        std::size_t iterations_{0};
+        std::size_t solveCalls_{0};
+
+        template <typename DoneFn>
+        void solve(DoneFn done) {
+            ++solveCalls_;
+            while (!done())
+                ++iterations_;
+        }
+    };
+
+    struct ThrowingPlanner {
+        template <typename DoneFn>
+        void solve(DoneFn) {
+            throw std::runtime_error("planner failed");
+        }
+    };
+}
+
+TEST(done_predicate) {
+    CountingPlanner planner;
+    {
+        PlannerExecutor executor(2, 16);
+        auto future = executor.submitFor(
+            planner, std::chrono::hours(1),
+            [&] { return planner.iterations_ >= 1000; });
+        future.get();
+    }
+    EXPECT(planner.iterations_) == 1000u;
+}
+
+TEST(deadline) {
+    CountingPlanner planner;
+    PlannerExecutor executor(1, 16);
+    auto start = PlannerExecutor::Clock::now();
+    executor.submitFor(planner, std::chrono::milliseconds(20)).get();
+    auto elapsed = PlannerExecutor::Clock::now() - start;
+    EXPECT(elapsed >= std::chrono::milliseconds(20)) == true;
+    EXPECT(planner.iterations_ > 0) == true;
+}
+
+TEST(expired_deadline) {
+    CountingPlanner planner;
+    PlannerExecutor executor(1);
+    executor.submit(planner, PlannerExecutor::Clock::now() - std::chrono::seconds(1)).get();
+    EXPECT(planner.solveCalls_) == 0u;
+}
+
+TEST(earliest_deadline_first) {
+    // With a single thread, the planner with the earlier deadline
+    // must finish first, even though it was submitted second.  The
+    // blocker occupies the thread until both have been queued.
+    CountingPlanner blocker;
+    CountingPlanner late;
+    CountingPlanner early;
+    PlannerExecutor executor(1, 8);
+    auto now = PlannerExecutor::Clock::now();
+    std::atomic<bool> released{false};
+    int order = 0;
+    int lateDone = 0;
+    int earlyDone = 0;
+
+    auto blockerFuture = executor.submit(blocker, now + std::chrono::minutes(30), [&] {
+        return released.load();
+    });
+    auto lateFuture = executor.submit(late, now + std::chrono::hours(2), [&] {
+        if (late.iterations_ < 1000) return false;
+        lateDone = ++order;
+        return true;
+    });
+    auto earlyFuture = executor.submit(early, now + std::chrono::hours(1), [&] {
+        if (early.iterations_ < 1000) return false;
+        earlyDone = ++order;
+        return true;
+    });
+    released = true;
+
+    blockerFuture.get();
+    earlyFuture.get();
+    lateFuture.get();
+
+    EXPECT(earlyDone) == 1;
+    EXPECT(lateDone) == 2;
+}
+
+TEST(exception) {
+    ThrowingPlanner planner;
+    PlannerExecutor executor(1);
+    auto future = executor.submitFor(planner, std::chrono::seconds(1));
+    bool caught = false;
+    try {
+        future.get();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    EXPECT(caught) == true;
+}
@@ -0,0 +1,83 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/pprm.hpp>
+#include <mpt/prrt.hpp>
+#include <mpt/prrt_star.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+
+using namespace unc::robotics::mpt;
+
+// After reset(), the planner must be empty but keep its pool blocks,
+// and a second solve must reuse those blocks (the second graph is
+// kept smaller than the first) and find a valid path.
+template <typename Algorithm>
+static void expectResetAndSolve() {
+    Planner<PointScenario, Algorithm> planner(PointScenario{});
+    planner.addStart(PointScenario::start());
+    planner.solve([&] { return planner.solved() && planner.size() >= 2000; });
+    EXPECT(planner.solved()) == true;
+    EXPECT(planner.stats().iterations_ > 0) == true;
+    std::size_t bytes = planner.memoryStats().bytes("nodes");
+    std::size_t firstSize = planner.size();
+
+    planner.reset();
+    EXPECT(planner.size()) == 0u;
+    EXPECT(planner.solved()) == false;
+    EXPECT(planner.solution().empty()) == true;
+    EXPECT(planner.memoryStats().objects("nodes")) == 0u;
+    EXPECT(planner.memoryStats().objects("goals")) == 0u;
+    EXPECT(planner.memoryStats().bytes("nodes")) == bytes;
+    EXPECT(planner.stats().iterations_) == 0u;
+
+    planner.addStart(PointScenario::start());
+    planner.solve([&] { return planner.solved() || planner.size() >= firstSize / 2; });
+    EXPECT(planner.solved()) == true;
+    EXPECT(PointScenario{}.validPath(planner.solution())) == true;
+    EXPECT(planner.memoryStats().bytes("nodes")) == bytes;
+}
+
+TEST(prrt) {
+    expectResetAndSolve<PRRT<max_threads<1>, report_stats<true>>>();
+}
+
+TEST(prrt_star) {
+    expectResetAndSolve<PRRTStar<max_threads<1>, report_stats<true>>>();
+}
+
+TEST(pprm) {
+    expectResetAndSolve<PPRM<max_threads<1>, report_stats<true>>>();
+}
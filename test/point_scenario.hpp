@@ -0,0 +1,90 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#pragma once
+#ifndef MPT_TEST_POINT_SCENARIO_HPP
+#define MPT_TEST_POINT_SCENARIO_HPP
+
+#include <mpt/box_bounds.hpp>
+#include <mpt/goal_state.hpp>
+#include <mpt/lp_space.hpp>
+#include <vector>
+
+// A small planning problem shared by the planner tests: a point in
+// the unit square moves around a disc obstacle in its center, from
+// near (0.1,0.1) to a goal near (0.9,0.9).
+struct PointScenario {
+    using Space = unc::robotics::mpt::L2Space<double, 2>;
+    using State = Space::Type;
+    using Distance = double;
+    using Goal = unc::robotics::mpt::GoalState<Space>;
+    using Bounds = unc::robotics::mpt::BoxBounds<double, 2>;
+
+    Space space_;
+    Bounds bounds_{State(0, 0), State(1, 1)};
+    Goal goal_{0.05, State(0.9, 0.9)};
+
+    const Space& space() const { return space_; }
+    const Bounds& bounds() const { return bounds_; }
+    const Goal& goal() const { return goal_; }
+
+    bool valid(const State& q) const {
+        return (q - State(0.5, 0.5)).norm() > 0.2;
+    }
+
+    bool link(const State& a, const State& b) const {
+        for (int i = 1 ; i <= 20 ; ++i)
+            if (!valid(a + (b - a) * (i / 20.0)))
+                return false;
+        return true;
+    }
+
+    static State start() {
+        return State(0.1, 0.1);
+    }
+
+    // true if path starts at the start, ends in the goal, and each
+    // motion along it is valid.
+    bool validPath(const std::vector<State>& path) const {
+        if (path.size() < 2 || path.front() != start() || !goal_(space_, path.back()).first)
+            return false;
+        for (std::size_t i = 1 ; i < path.size() ; ++i)
+            if (!link(path[i-1], path[i]))
+                return false;
+        return true;
+    }
+};
+
+#endif
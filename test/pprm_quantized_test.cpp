@@ -0,0 +1,123 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/pprm.hpp>
+#include <mpt/shared_segment.hpp>
+#include <mpt/state_codec.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using namespace unc::robotics::mpt;
+
+using State = PointScenario::State;
+
+// a valid state next to the obstacle, whose quantized state is
+// inside the obstacle.
+static State startNearObstacle() {
+    PointScenario scenario;
+    StateCodec<PointScenario::Space, PointScenario::Bounds> codec(scenario.space(), scenario.bounds());
+    for (int i = 0 ; ; ++i) {
+        double a = 3.9 + i * 1e-4;
+        State q = State(0.5, 0.5) + State(std::cos(a), std::sin(a)) * (0.2 + 1e-6);
+        if (scenario.valid(q) && !scenario.valid(codec.decode(codec.encode(q))))
+            return q;
+    }
+}
+
+// true if the path goes from start to the goal with valid motions.
+static bool validPath(const std::vector<State>& path, const State& start) {
+    PointScenario scenario;
+    if (path.size() < 2 || path.front() != start || !scenario.goal()(scenario.space(), path.back()).first)
+        return false;
+    for (std::size_t i = 1 ; i < path.size() ; ++i)
+        if (!scenario.link(path[i-1], path[i]))
+            return false;
+    return true;
+}
+
+TEST(start_near_obstacle) {
+    State start = startNearObstacle();
+    Planner<PointScenario, PPRM<single_threaded, quantized_states>> planner(PointScenario{});
+    planner.addStart(start);
+    planner.solve([&] { return planner.solved(); });
+    EXPECT(validPath(planner.solution(), start)) == true;
+
+    planner.compact();
+    EXPECT(validPath(planner.solution(), start)) == true;
+}
+
+TEST(invalid_start_or_goal) {
+    Planner<PointScenario, PPRM<single_threaded, quantized_states>> planner(PointScenario{});
+    bool threw = false;
+    try {
+        planner.addStart(0.5, 0.5);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT(threw) == true;
+
+    threw = false;
+    try {
+        planner.addGoal(0.5, 0.4);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT(threw) == true;
+}
+
+// the exact start recorded by one planner is visible to a planner
+// on another mapping of the segment, which adds the same start.
+TEST(shared_start_near_obstacle) {
+    using Algorithm = PPRM<single_threaded, quantized_states, shared_roadmap>;
+    std::string name = "/mpt_test_" + std::to_string(::getpid()) + "_quantized";
+    SharedSegment segmentA = SharedSegment::create(name, 64 << 20);
+    SharedSegment segmentB = SharedSegment::open(name);
+    SharedSegment::unlink(name);
+
+    State start = startNearObstacle();
+    Planner<PointScenario, Algorithm> a(PointScenario{}, segmentA);
+    a.addStart(start);
+    a.solve([&] { return a.solved(); });
+    EXPECT(validPath(a.solution(), start)) == true;
+
+    Planner<PointScenario, Algorithm> b(PointScenario{}, segmentB);
+    b.addStart(start);
+    b.solve([&] { return b.solved(); });
+    EXPECT(validPath(b.solution(), start)) == true;
+}
@@ -0,0 +1,83 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/pprm.hpp>
+#include <mpt/shared_segment.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+#include <string>
+#include <unistd.h>
+
+using namespace unc::robotics::mpt;
+
+using State = PointScenario::State;
+
+// true if each motion along the path is valid.
+static bool validMotions(const PointScenario& scenario, const std::vector<State>& path) {
+    for (std::size_t i = 1 ; i < path.size() ; ++i)
+        if (!scenario.link(path[i-1], path[i]))
+            return false;
+    return true;
+}
+
+// Two planners on two mappings of a segment (as two processes would
+// be) with different goals.  The second planner starts with the
+// first's solved roadmap, whose components have the first planner's
+// start and goal flags, and must only be solved once its own start
+// is connected to its own goal.
+TEST(per_planner_goals) {
+    using Algorithm = PPRM<max_threads<2>, shared_roadmap>;
+    std::string name = "/mpt_test_" + std::to_string(::getpid()) + "_shared";
+    SharedSegment segmentA = SharedSegment::create(name, 64 << 20);
+    SharedSegment segmentB = SharedSegment::open(name);
+    SharedSegment::unlink(name);
+
+    PointScenario scenarioA;
+    Planner<PointScenario, Algorithm> a(scenarioA, segmentA);
+    a.addStart(PointScenario::start());
+    a.solve([&] { return a.solved(); });
+    EXPECT(scenarioA.validPath(a.solution())) == true;
+
+    PointScenario scenarioB;
+    scenarioB.goal_ = PointScenario::Goal(0.05, State(0.1, 0.9));
+    Planner<PointScenario, Algorithm> b(scenarioB, segmentB);
+    b.addStart(State(0.9, 0.1));
+    b.solve([&] { return b.solved(); });
+    std::vector<State> path = b.solution();
+    EXPECT(path.size() >= 2) == true;
+    EXPECT(path.front() == State(0.9, 0.1)) == true;
+    EXPECT(scenarioB.goal()(scenarioB.space(), path.back()).first) == true;
+    EXPECT(validMotions(scenarioB, path)) == true;
+}
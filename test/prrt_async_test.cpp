@@ -0,0 +1,125 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/prrt.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace unc::robotics::mpt;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // a future whose result becomes ready at a fixed time, without
+    // any thread computing it.
+    class MockFuture {
+        Clock::time_point ready_;
+        bool result_{false};
+
+    public:
+        MockFuture() = default;
+        MockFuture(Clock::time_point ready, bool result) : ready_(ready), result_(result) {}
+
+        void wait() const {
+            std::this_thread::sleep_until(ready_);
+        }
+
+        template <typename Rep, typename Period>
+        std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+            std::this_thread::sleep_until(std::min<Clock::time_point>(Clock::now() + timeout, ready_));
+            return Clock::now() >= ready_
+                ? std::future_status::ready
+                : std::future_status::timeout;
+        }
+
+        bool get() {
+            wait();
+            return result_;
+        }
+    };
+
+    // a scenario whose checks take 'latency' to complete.
+    struct AsyncScenario : PointScenario {
+        static inline std::atomic<int> validCalls{0};
+        static inline std::atomic<int> linkCalls{0};
+        std::chrono::milliseconds latency_;
+
+        explicit AsyncScenario(std::chrono::milliseconds latency = std::chrono::milliseconds(0))
+            : latency_(latency)
+        {
+        }
+
+        MockFuture validAsync(const State& q) const {
+            ++validCalls;
+            return MockFuture(Clock::now() + latency_, valid(q));
+        }
+
+        MockFuture linkAsync(const State& a, const State& b) const {
+            ++linkCalls;
+            return MockFuture(Clock::now() + latency_, link(a, b));
+        }
+    };
+
+    using AsyncPRRT = PRRT<single_threaded, async_depth<4>>;
+}
+
+TEST(solve) {
+    AsyncScenario::validCalls = 0;
+    AsyncScenario::linkCalls = 0;
+    Planner<AsyncScenario, AsyncPRRT> planner(AsyncScenario(std::chrono::milliseconds(1)));
+    planner.addStart(PointScenario::start());
+    planner.solveFor([&] { return planner.solved(); }, std::chrono::seconds(10));
+    EXPECT(planner.solved()) == true;
+    EXPECT(PointScenario{}.validPath(planner.solution())) == true;
+    EXPECT(AsyncScenario::validCalls > 0) == true;
+    EXPECT(AsyncScenario::linkCalls > 0) == true;
+}
+
+TEST(deadline) {
+    // the checks in flight at the deadline take far longer than
+    // the deadline, and must not be waited on.
+    Planner<AsyncScenario, AsyncPRRT> planner(AsyncScenario(std::chrono::seconds(2)));
+    planner.addStart(PointScenario::start());
+    auto start = Clock::now();
+    planner.solveFor([] { return false; }, std::chrono::milliseconds(50));
+    auto elapsed = Clock::now() - start;
+    EXPECT(elapsed < std::chrono::milliseconds(1000)) == true;
+    EXPECT(planner.memoryStats().objects("in-flight samples")) == 0u;
+}
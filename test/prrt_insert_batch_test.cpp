@@ -0,0 +1,76 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/prrt.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+#include <algorithm>
+
+using namespace unc::robotics::mpt;
+
+// With a batch larger than the tree, no nodes are published while
+// solving, so the worker can only grow the tree (and find a path
+// around the obstacle) through the linear search of its unpublished
+// nodes.  They must all be in the nearest neighbor structure once
+// solve returns.
+TEST(unpublished) {
+    Planner<PointScenario, PRRT<max_threads<1>, insert_batch<1000>>> planner;
+    planner.addStart(PointScenario::start());
+    std::size_t maxSize = 0;
+    planner.solve([&] {
+        maxSize = std::max(maxSize, planner.size());
+        return planner.solved() || planner.memoryStats().objects("nodes") >= 900;
+    });
+    EXPECT(planner.solved()) == true;
+    EXPECT(maxSize) == 1u;
+    EXPECT(planner.solution().size() > 2) == true;
+    EXPECT(PointScenario{}.validPath(planner.solution())) == true;
+    EXPECT(planner.size()) == 1 + planner.memoryStats().objects("nodes");
+    EXPECT(planner.memoryStats().objects("unpublished nodes")) == 0u;
+}
+
+// nodes are published every insertBatch nodes while solving.
+TEST(published) {
+    Planner<PointScenario, PRRT<max_threads<1>, insert_batch<4>>> planner;
+    planner.addStart(PointScenario::start());
+    bool inBatch = true;
+    planner.solve([&] {
+        std::size_t nodes = planner.memoryStats().objects("nodes");
+        inBatch &= planner.size() == 1 + nodes - nodes % 4;
+        return planner.solved();
+    });
+    EXPECT(inBatch) == true;
+    EXPECT(planner.size()) == 1 + planner.memoryStats().objects("nodes");
+}
@@ -0,0 +1,79 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/prrt.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+using namespace unc::robotics::mpt;
+
+namespace {
+    using Pipeline = PRRT<pipeline<1, 1, 1, 1>>;
+
+    // a scenario whose motion checks fail with an exception after a
+    // number of calls.
+    struct ThrowingScenario : PointScenario {
+        static inline std::atomic<int> calls{0};
+
+        bool link(const State& a, const State& b) const {
+            if (++calls > 50)
+                throw std::runtime_error("link failed");
+            return PointScenario::link(a, b);
+        }
+    };
+}
+
+TEST(solve) {
+    Planner<PointScenario, Pipeline> planner;
+    planner.addStart(PointScenario::start());
+    planner.solveFor([&] { return planner.solved(); }, std::chrono::seconds(10));
+    EXPECT(planner.solved()) == true;
+    EXPECT(PointScenario{}.validPath(planner.solution())) == true;
+}
+
+TEST(rethrow) {
+    Planner<ThrowingScenario, Pipeline> planner;
+    planner.addStart(PointScenario::start());
+    bool thrown = false;
+    try {
+        planner.solve([] { return false; });
+    } catch (const std::runtime_error& ex) {
+        thrown = std::string(ex.what()) == "link failed";
+    }
+    EXPECT(thrown) == true;
+}
@@ -0,0 +1,68 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/prrt_star.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+
+using namespace unc::robotics::mpt;
+
+// With multiple threads rewiring, a worker retires links that other
+// workers allocated.  Superseded links are split out of the links
+// only for the whole planner, so every count stays within the links
+// allocated, and the links in the tree are at least one per node.
+TEST(superseded_links) {
+    Planner<PointScenario, PRRTStar<max_threads<4>>> planner(PointScenario{});
+    planner.addStart(PointScenario::start());
+
+    bool bounded = true;
+    bool superseded = false;
+    for (std::size_t target = 1000 ; target <= 8000 ; target += 1000) {
+        planner.solve([&] { return planner.size() >= target; });
+
+        std::size_t allocated = 0;
+        for (unsigned i=0 ; i<planner.workerCount() ; ++i)
+            allocated += planner.memoryStats(i).objects("links");
+
+        auto stats = planner.memoryStats();
+        std::size_t live = stats.objects("links");
+        std::size_t dead = stats.objects("superseded links");
+        bounded &= live + dead == allocated;
+        bounded &= live >= stats.objects("nodes") && live <= allocated;
+        superseded |= dead > 0;
+    }
+    EXPECT(bounded) == true;
+    EXPECT(superseded) == true;
+}
@@ -0,0 +1,110 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/pprm.hpp>
+#include <mpt/prrt.hpp>
+#include <mpt/prrt_star.hpp>
+#include "point_scenario.hpp"
+#include "test.hpp"
+#include <atomic>
+
+using namespace unc::robotics::mpt;
+
+namespace {
+    // the point scenario with batched checks that count their calls
+    // and the states they check.
+    struct BatchScenario : PointScenario {
+        static inline std::atomic<int> validBatchCalls{0};
+        static inline std::atomic<int> linkBatchCalls{0};
+        static inline std::atomic<int> links{0};
+
+        void validBatch(const State* states, std::size_t n, bool* valid) const {
+            ++validBatchCalls;
+            for (std::size_t i=0 ; i<n ; ++i)
+                valid[i] = PointScenario::valid(states[i]);
+        }
+
+        void linkBatch(const State* from, const State* to, std::size_t n, bool* valid) const {
+            ++linkBatchCalls;
+            links += n;
+            for (std::size_t i=0 ; i<n ; ++i)
+                valid[i] = PointScenario::link(from[i], to[i]);
+        }
+
+        static void resetCounts() {
+            validBatchCalls = 0;
+            linkBatchCalls = 0;
+            links = 0;
+        }
+    };
+
+    template <typename Scenario, typename Algorithm>
+    std::vector<PointScenario::State> solveOnce(std::size_t& size) {
+        Planner<Scenario, Algorithm> planner(Scenario{}, FixedSeed(3));
+        planner.addStart(PointScenario::start());
+        planner.solve([&] { return planner.size() >= 400; });
+        size = planner.size();
+        return planner.solution();
+    }
+
+    // a single-threaded run with the scenario's batched checks must
+    // build the same graph as a run with the fallback to valid() and
+    // link(), and the batched checks must be called.
+    template <typename Algorithm>
+    void expectBatched() {
+        BatchScenario::resetCounts();
+        std::size_t batchSize, loopSize;
+        auto batchPath = solveOnce<BatchScenario, Algorithm>(batchSize);
+        auto loopPath = solveOnce<PointScenario, Algorithm>(loopSize);
+        EXPECT(BatchScenario::validBatchCalls > 0) == true;
+        EXPECT(BatchScenario::linkBatchCalls > 0) == true;
+        EXPECT(BatchScenario::links > BatchScenario::linkBatchCalls) == true;
+        EXPECT(batchSize) == loopSize;
+        EXPECT(batchPath == loopPath) == true;
+        EXPECT(PointScenario{}.validPath(batchPath)) == true;
+    }
+}
+
+TEST(prrt) {
+    expectBatched<PRRT<single_threaded, sample_batch<8>>>();
+}
+
+TEST(prrt_star) {
+    expectBatched<PRRTStar<single_threaded, sample_batch<8>>>();
+}
+
+TEST(pprm) {
+    expectBatched<PPRM<single_threaded, sample_batch<8>>>();
+}
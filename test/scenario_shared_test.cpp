@@ -0,0 +1,76 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/impl/scenario_shared.hpp>
+#include <memory>
+#include "test.hpp"
+
+using namespace unc::robotics::mpt;
+
+struct CopiedScenario {
+    int copies_{0};
+
+    CopiedScenario() = default;
+    CopiedScenario(const CopiedScenario& other) : copies_(other.copies_ + 1) {}
+};
+
+struct SharedScenario {
+    std::shared_ptr<const int> shared_;
+    int scratch_{0};
+
+    explicit SharedScenario(int value) : shared_(std::make_shared<const int>(value)) {}
+    SharedScenario(const std::shared_ptr<const int>& shared) : shared_(shared), scratch_(-1) {}
+
+    std::shared_ptr<const int> shared() const { return shared_; }
+};
+
+TEST(detect) {
+    EXPECT(impl::scenario_has_shared_v<CopiedScenario>) == false;
+    EXPECT(impl::scenario_has_shared_v<SharedScenario>) == true;
+}
+
+TEST(copy) {
+    CopiedScenario scenario;
+    CopiedScenario worker = impl::workerScenario(scenario);
+    EXPECT(worker.copies_) == 1;
+}
+
+TEST(shared) {
+    SharedScenario scenario(42);
+    SharedScenario worker = impl::workerScenario(scenario);
+    EXPECT(worker.shared_.get()) == scenario.shared_.get();
+    EXPECT(*worker.shared_) == 42;
+    EXPECT(worker.scratch_) == -1;
+}
@@ -0,0 +1,208 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/shared_segment.hpp>
+#include <mpt/impl/offset_ptr.hpp>
+#include "test.hpp"
+#include <chrono>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace unc::robotics::mpt;
+using namespace unc::robotics::mpt::impl;
+
+static std::string segmentName(const char *test) {
+    return "/mpt_test_" + std::to_string(::getpid()) + "_" + test;
+}
+
+TEST(offset_ptr) {
+    int values[2] = { 1, 2 };
+    OffsetPtr<int> p(&values[1]);
+    EXPECT(*p.get()) == 2;
+    OffsetPtr<int> q(p);
+    EXPECT(q.get() == &values[1]) == true;
+    q = nullptr;
+    EXPECT(q.get() == nullptr) == true;
+
+    AtomicOffsetPtr<int> a(&values[0]);
+    int *expect = &values[1];
+    EXPECT(a.compare_exchange_strong(expect, nullptr)) == false;
+    EXPECT(expect == &values[0]) == true;
+    EXPECT(a.compare_exchange_strong(expect, &values[1])) == true;
+    EXPECT(a.load() == &values[1]) == true;
+}
+
+TEST(allocate) {
+    std::string name = segmentName("allocate");
+    SharedSegment segment = SharedSegment::create(name, 4096);
+    SharedSegment::unlink(name);
+
+    double *d = segment.construct<double>(1.5);
+    EXPECT(*d) == 1.5;
+    EXPECT(reinterpret_cast<std::uintptr_t>(d) % alignof(double)) == 0u;
+    EXPECT(segment.contains(d)) == true;
+
+    bool threw = false;
+    try {
+        segment.allocate(8192, 8);
+    } catch (const std::bad_alloc&) {
+        threw = true;
+    }
+    EXPECT(threw) == true;
+}
+
+TEST(two_mappings) {
+    // opening the same segment twice maps it at two addresses, as
+    // would happen in two processes.
+    std::string name = segmentName("two_mappings");
+    SharedSegment a = SharedSegment::create(name, 1 << 16);
+    SharedSegment b = SharedSegment::open(name);
+    SharedSegment::unlink(name);
+
+    struct Link {
+        int value_;
+        AtomicOffsetPtr<Link> next_{nullptr};
+        Link(int value) : value_(value) {}
+    };
+
+    unsigned ownerA = a.newOwner();
+    unsigned ownerB = b.newOwner();
+    EXPECT(ownerA != ownerB) == true;
+
+    Link *first = a.construct<Link>(1);
+    Link *second = a.construct<Link>(2);
+    first->next_.store(second);
+    a.record(0, first, ownerA);
+
+    std::uint64_t head = b.head(0);
+    int sum = 0;
+    b.forEach<Link>(head, 0, [&] (Link *l, unsigned owner) {
+        EXPECT(owner) == ownerA;
+        EXPECT(b.contains(l)) == true;
+        for ( ; l ; l = l->next_.load())
+            sum += l->value_;
+    });
+    EXPECT(sum) == 3;
+    EXPECT(b.used()) == a.used();
+
+    // records after 'head' are the only ones visited.
+    b.record(0, b.construct<Link>(4), ownerB);
+    int count = 0;
+    a.forEach<Link>(a.head(0), head, [&] (Link *l, unsigned owner) {
+        EXPECT(owner) == ownerB;
+        EXPECT(l->value_) == 4;
+        ++count;
+    });
+    EXPECT(count) == 1;
+}
+
+TEST(open_or_create) {
+    std::string name = segmentName("open_or_create");
+    SharedSegment a = SharedSegment::openOrCreate(name, 4096);
+    SharedSegment b = SharedSegment::openOrCreate(name, 4096);
+    SharedSegment::unlink(name);
+    a.construct<int>(7);
+    EXPECT(b.used()) == a.used();
+}
+
+TEST(open_or_create_race) {
+    // processes that start together race between create() sizing
+    // and initializing the segment and open() mapping it.  All of
+    // them must get the same initialized segment.
+    constexpr int kProcesses = 8;
+    constexpr int kRounds = 50;
+    int failures = 0;
+    for (int round = 0 ; round < kRounds ; ++round) {
+        std::string name = segmentName("race");
+        int start[2];
+        EXPECT(::pipe(start)) == 0;
+        pid_t pids[kProcesses];
+        for (int i = 0 ; i < kProcesses ; ++i) {
+            if ((pids[i] = ::fork()) == 0) {
+                ::close(start[1]);
+                char c;
+                (void)::read(start[0], &c, 1); // returns when the parent closes the pipe
+                int status = 0;
+                try {
+                    SharedSegment segment = SharedSegment::openOrCreate(name, 1 << 16);
+                    unsigned owner = segment.newOwner();
+                    segment.record(0, segment.construct<unsigned>(owner), owner);
+                } catch (...) {
+                    status = 1;
+                }
+                ::_exit(status);
+            }
+        }
+        ::close(start[0]);
+        ::close(start[1]);
+        for (pid_t pid : pids) {
+            int status;
+            ::waitpid(pid, &status, 0);
+            failures += !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+        }
+
+        SharedSegment segment = SharedSegment::open(name);
+        SharedSegment::unlink(name);
+        int records = 0;
+        bool ownersMatch = true;
+        segment.forEach<unsigned>(segment.head(0), 0, [&] (unsigned *value, unsigned owner) {
+            ownersMatch &= *value == owner;
+            ++records;
+        });
+        EXPECT(records) == kProcesses;
+        EXPECT(ownersMatch) == true;
+    }
+    EXPECT(failures) == 0;
+}
+
+TEST(open_uninitialized) {
+    // a segment that is never initialized times out instead of
+    // hanging or failing with a stale errno.
+    std::string name = segmentName("uninitialized");
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    EXPECT(fd != -1) == true;
+    ::close(fd);
+    bool threw = false;
+    try {
+        SharedSegment::open(name, std::chrono::milliseconds(20));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    SharedSegment::unlink(name);
+    EXPECT(threw) == true;
+}
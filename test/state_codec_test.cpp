@@ -0,0 +1,108 @@
+// Software License Agreement (BSD-3-Clause)
+//
+// Copyright 2018 The University of North Carolina at Chapel Hill
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! @author Jeff Ichnowski
+
+#include <mpt/state_codec.hpp>
+#include <mpt/lp_space.hpp>
+#include <mpt/so3_space.hpp>
+#include <mpt/se3_space.hpp>
+#include <mpt/cartesian_bounds.hpp>
+#include "test.hpp"
+#include <random>
+
+using namespace unc::robotics::mpt;
+
+TEST(lp_roundtrip) {
+    using Space = L2Space<double, 3>;
+    using Bounds = BoxBounds<double, 3>;
+    Space space;
+    Bounds bounds(Eigen::Vector3d(-1, 0, 2), Eigen::Vector3d(1, 4, 2));
+    StateCodec<Space, Bounds> codec(space, bounds);
+
+    static_assert(sizeof(StateCodec<Space, Bounds>::Encoded) == 6);
+
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> dist(0, 1);
+    double maxError = 0;
+    bool stable = true;
+    for (int i=0 ; i<1000 ; ++i) {
+        Eigen::Vector3d q(dist(rng)*2 - 1, dist(rng)*4, 2);
+        auto e = codec.encode(q);
+        Eigen::Vector3d r = codec.decode(e);
+        maxError = std::max(maxError, (q - r).cwiseAbs().maxCoeff());
+        stable &= codec.encode(r) == e;
+    }
+    EXPECT(maxError) < 4.0 / 65535;
+    EXPECT(stable) == true;
+
+    // out of bounds coordinates are clamped
+    Eigen::Vector3d r = codec.decode(codec.encode(Eigen::Vector3d(-5, 9, 2)));
+    EXPECT((r - Eigen::Vector3d(-1, 4, 2)).norm()) < 1e-12;
+}
+
+TEST(so3_roundtrip) {
+    using Space = SO3Space<double>;
+    Space space;
+    StateCodec<Space, Unbounded> codec(space);
+
+    std::mt19937_64 rng(2);
+    std::normal_distribution<double> dist;
+    double maxError = 0;
+    for (int i=0 ; i<1000 ; ++i) {
+        Eigen::Quaterniond q(dist(rng), dist(rng), dist(rng), dist(rng));
+        q.normalize();
+        Eigen::Quaterniond r = codec.decode(codec.encode(q));
+        maxError = std::max(maxError, space.distance(q, r));
+        if (std::abs(r.norm() - 1) > 1e-12)
+            maxError = 1;
+    }
+    EXPECT(maxError) < 1e-5;
+}
+
+TEST(se3_roundtrip) {
+    using Space = SE3Space<double>;
+    using Bounds = CartesianBounds<Unbounded, BoxBounds<double, 3>>;
+    using State = Space::Type;
+    Space space;
+    Bounds bounds(Eigen::Vector3d(-1, -1, -1), Eigen::Vector3d(1, 1, 1));
+    StateCodec<Space, Bounds> codec(space, bounds);
+
+    static_assert(sizeof(StateCodec<Space, Bounds>::Encoded) <= 16);
+
+    State q;
+    std::get<0>(q) = Eigen::AngleAxisd(0.7, Eigen::Vector3d::UnitY());
+    std::get<1>(q) = Eigen::Vector3d(0.25, -0.5, 0.75);
+    State r = codec.decode(codec.encode(q));
+    EXPECT(space.distance(q, r)) < 1e-4;
+}